@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+#include "susolv/batch.h"
+#include "susolv/board.h"
+#include "susolv/euler96.h"
+#include "susolv/susolv.h"
+#include "susolv/timing.h"
+
+/**
+ * per-call overhead of solveBatch for batch sizes 1..4096.
+ * the euler96 set is repeated to fill a 4096 puzzle pool, then the whole pool is pushed through
+ * solveBatch in calls of each batch size; the difference to the 4096-wide number is the per-call cost.
+ * the old `std::optional<Board> solve(...)` loop over a vector<Board> is timed too, for reference.
+ */
+
+static constexpr size_t POOL_SIZE = 4096;
+static constexpr int ROUNDS = 5;
+
+int main(int argc, char** argv) {
+    const char* fname = argc > 1 ? argv[1] : SUSOLV_BOARDS_DIR "euler96-all.txt";
+    std::vector<Board> boards = loadEuler96(fname);
+
+    std::vector<char> puzzles(POOL_SIZE * BOARD_CELLS);
+    std::vector<char> solutions(POOL_SIZE * BOARD_CELLS);
+    std::vector<BatchStatus> statuses(POOL_SIZE);
+    std::vector<Board> pool;
+    pool.reserve(POOL_SIZE);
+
+    for (size_t i = 0; i < POOL_SIZE; ++i) {
+        writeBoard(boards[i % boards.size()], &puzzles[i * BOARD_CELLS]);
+        pool.push_back(boards[i % boards.size()]);
+    }
+
+    auto best = [](auto&& f) {
+        int64_t bestNs = INT64_MAX;
+        for (int round = 0; round < ROUNDS; ++round) {
+            bestNs = std::min<int64_t>(bestNs, toNanos(withTime(f).elapsed));
+        }
+        return bestNs;
+    };
+
+    const int64_t optionalNs = best([&]() {
+        uint64_t sum = 0;
+        for (const Board& board : pool) {
+            std::optional<Board> solved = solve(board);
+            sum += solved ? solved->getSolvedValue(static_cast<uint8_t>(0)) : 0;
+        }
+        return sum;
+    });
+
+    std::cout << "pool: " << POOL_SIZE << " puzzles (" << boards.size() << " unique), best of " << ROUNDS << "\n";
+    std::cout << "solve() -> optional<Board>: " << optionalNs / POOL_SIZE << " ns/puzzle\n\n";
+    std::cout << "batch   ns/puzzle   ns/call\n";
+
+    for (size_t batchSize = 1; batchSize <= POOL_SIZE; batchSize *= 2) {
+        const int64_t ns = best([&]() {
+            size_t solved = 0;
+            for (size_t offset = 0; offset < POOL_SIZE; offset += batchSize) {
+                solved += solveBatch(&puzzles[offset * BOARD_CELLS], &solutions[offset * BOARD_CELLS], &statuses[offset], batchSize);
+            }
+            return solved;
+        });
+        std::cout << batchSize << "\t" << ns / POOL_SIZE << "\t\t" << ns / (POOL_SIZE / batchSize) << "\n";
+    }
+
+    const int64_t cNs = best([&]() {
+        size_t solved = 0;
+        for (size_t offset = 0; offset < POOL_SIZE; ++offset) {
+            solved += susolv_solve(&puzzles[offset * BOARD_CELLS], &solutions[offset * BOARD_CELLS]) == SUSOLV_SOLVED;
+        }
+        return solved;
+    });
+    std::cout << "\nsusolv_solve (C ABI, 1 per call): " << cNs / POOL_SIZE << " ns/puzzle\n";
+
+    return 0;
+}
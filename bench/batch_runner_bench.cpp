@@ -0,0 +1,69 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "susolv/batchRunner.h"
+#include "susolv/timing.h"
+
+/**
+ * cost of checkpointing in runBatch.
+ * the input (hard.txt unless given) is repeated into a scratch file of a few hundred puzzles, and run
+ * with no checkpoints, then at a few intervals, with and without fsync. best of ROUNDS each.
+ */
+
+static constexpr int REPEATS = 5;
+static constexpr int ROUNDS = 3;
+
+int main(int argc, char** argv) {
+    namespace fs = std::filesystem;
+
+    const char* fname = argc > 1 ? argv[1] : SUSOLV_BOARDS_DIR "hard.txt";
+    const fs::path dir = fs::temp_directory_path() / "susolv_batch_runner_bench";
+    fs::create_directories(dir);
+
+    {
+        std::ifstream in(fname, std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        std::ofstream out(dir / "in.txt", std::ios::binary);
+        for (int i = 0; i < REPEATS; ++i) {
+            out << ss.str();
+        }
+    }
+
+    auto run = [&](uint64_t every, bool sync) {
+        BatchRunOptions options;
+        options.inputPath = (dir / "in.txt").string();
+        options.outputPath = (dir / "out.txt").string();
+        options.checkpointPath = every ? (dir / "out.ckpt").string() : "";
+        options.checkpointEvery = every;
+        options.sync = sync;
+        options.solve.engine = SolveEngine::bitboard;
+
+        int64_t bestNs = INT64_MAX;
+        BatchRunStats stats;
+        for (int round = 0; round < ROUNDS; ++round) {
+            bestNs = std::min<int64_t>(bestNs, toNanos(withTime([&]() { return runBatch(options, stats); }).elapsed));
+        }
+        return std::make_pair(bestNs, stats.completed);
+    };
+
+    const auto [baseNs, count] = run(0, false);
+    std::cout << count << " puzzles, best of " << ROUNDS << "\n";
+    std::cout << "every    sync   ns/puzzle   overhead\n";
+    std::cout << "never    -      " << baseNs / count << "\n";
+
+    for (bool sync : { false, true }) {
+        for (uint64_t every : { 1, 100, 10'000 }) {
+            const int64_t ns = run(every, sync).first;
+            std::cout << every << (every < 10 ? "        " : every < 1000 ? "      " : "    ")
+                << (sync ? "yes    " : "no     ") << ns / count << "       "
+                << 100.0 * (ns - baseNs) / baseNs << "%\n";
+        }
+    }
+
+    fs::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "susolv/batch.h"
+#include "susolv/board.h"
+#include "susolv/euler96.h"
+#include "susolv/timing.h"
+
+/**
+ * cell-major Board vs digit-major BitBoard on three sets:
+ *   easy     euler96 solutions with 45 random clues kept (there's no easy set in boards/)
+ *   euler96  boards/euler96-all.txt
+ *   17 clue  boards/17clue.txt
+ * and boards/hard.txt for good measure
+ */
+
+static constexpr int ROUNDS = 10;
+
+static int64_t bestOf(const std::vector<Board>& boards, SolveEngine engine) {
+    SolveOptions options;
+    options.engine = engine;
+    std::deque<Board> queue;
+    Board solved;
+
+    int64_t best = INT64_MAX;
+    for (int round = 0; round < ROUNDS; ++round) {
+        auto timed = withTime([&]() {
+            size_t n = 0;
+            SolveStats stats;
+            for (const Board& board : boards) n += solveInto(board, solved, queue, options, stats) == SolveStatus::solved;
+            return n;
+        });
+        best = std::min<int64_t>(best, toNanos(timed.elapsed));
+    }
+    return best;
+}
+
+static void run(const char* name, const std::vector<Board>& boards) {
+    const int64_t cellMajor = bestOf(boards, SolveEngine::cellMajor);
+    const int64_t bitboard = bestOf(boards, SolveEngine::bitboard);
+    std::cout << name << "\t" << boards.size() << "\t" << cellMajor / 1000.0 / boards.size() << "us\t\t"
+              << bitboard / 1000.0 / boards.size() << "us\t" << static_cast<double>(cellMajor) / bitboard << "x\n";
+}
+
+int main() {
+    std::vector<Board> euler = loadEuler96(SUSOLV_BOARDS_DIR "euler96-all.txt");
+
+    std::mt19937 rng(45);
+    std::vector<Board> easy;
+    for (const Board& board : euler) {
+        Board solution = *solve(board);
+        uint8_t order[81];
+        for (uint8_t i = 0; i < 81; ++i) order[i] = i;
+        std::shuffle(order, order + 81, rng);
+
+        Board puzzle;
+        for (uint8_t i = 0; i < 81; ++i) {
+            if (i < 45) {
+                puzzle.setSolved(order[i], solution.getSolvedValue(order[i]) - 1);
+            }
+            else {
+                puzzle.setUnknown(order[i]);
+            }
+        }
+        easy.push_back(puzzle);
+    }
+
+    std::cout << "best of " << ROUNDS << ", per puzzle\n";
+    std::cout << "set\tcount\tcell-major\tbitboard\tspeedup\n";
+    run("easy", easy);
+    run("euler96", euler);
+    run("17 clue", loadPackedBoards(SUSOLV_BOARDS_DIR "17clue.txt"));
+    run("hard", loadPackedBoards(SUSOLV_BOARDS_DIR "hard.txt"));
+
+    return 0;
+}
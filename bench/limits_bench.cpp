@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+#include "susolv/board.h"
+#include "susolv/euler96.h"
+#include "susolv/timing.h"
+
+/**
+ * cost of the deadline / node budget / stop token checks in the solve loop.
+ * "reference" is the search loop as it was before the checks went in, kept here verbatim;
+ * "no limits" is solve() with default options, "all limits" has every check armed (but never firing).
+ */
+
+static constexpr int ROUNDS = 200;
+
+static bool referenceSolve(const Board& board, Board& solved, std::deque<Board>& boards) {
+    boards.clear();
+    boards.push_back(board);
+    boards.front().fullComputeTakenVals();
+
+    while (boards.size() > 0) {
+        Board& workingBoard = boards.front();
+        Board::SimpleSolveResult result = workingBoard.simpleSolve();
+
+        if (result.solved) {
+            solved = workingBoard;
+            return true;
+        }
+        else if (result.invalid) {
+            boards.pop_front();
+        }
+        else {
+            for (auto iter = workingBoard.possibleSolutionsBegin(result.bestIndex); iter != workingBoard.possibleSolutionsEnd(); ++iter) {
+                boards.emplace_back(std::move(*iter));
+            }
+            boards.pop_front();
+        }
+    }
+
+    return false;
+}
+
+int main(int argc, char** argv) {
+    const char* fname = argc > 1 ? argv[1] : SUSOLV_BOARDS_DIR "euler96-all.txt";
+    std::vector<Board> boards = loadEuler96(fname);
+
+    std::stop_source source;
+    SolveOptions armed;
+    armed.deadline = SolveOptions::clock::now() + std::chrono::hours(1);
+    armed.nodeBudget = UINT64_MAX - 1;
+    armed.stopToken = source.get_token();
+
+    std::deque<Board> queue;
+    Board solved;
+
+    auto runReference = [&]() {
+        size_t n = 0;
+        for (const Board& board : boards) n += referenceSolve(board, solved, queue);
+        return n;
+    };
+    auto runWith = [&](const SolveOptions& options) {
+        return [&]() {
+            size_t n = 0;
+            SolveStats stats;
+            for (const Board& board : boards) n += solveInto(board, solved, queue, options, stats) == SolveStatus::solved;
+            return n;
+        };
+    };
+
+    const SolveOptions unlimited{};
+    int64_t best[3] = { INT64_MAX, INT64_MAX, INT64_MAX };
+
+    // interleave the three so drift (frequency scaling etc.) hits them equally
+    for (int round = 0; round < ROUNDS; ++round) {
+        best[0] = std::min<int64_t>(best[0], toNanos(withTime(runReference).elapsed));
+        best[1] = std::min<int64_t>(best[1], toNanos(withTime(runWith(unlimited)).elapsed));
+        best[2] = std::min<int64_t>(best[2], toNanos(withTime(runWith(armed)).elapsed));
+    }
+
+    std::cout << boards.size() << " boards, best of " << ROUNDS << "\n";
+    std::cout << "reference:  " << best[0] << "ns\n";
+    std::cout << "no limits:  " << best[1] << "ns (" << 100.0 * (best[1] - best[0]) / best[0] << "%)\n";
+    std::cout << "all limits: " << best[2] << "ns (" << 100.0 * (best[2] - best[0]) / best[0] << "%)\n";
+
+    return 0;
+}
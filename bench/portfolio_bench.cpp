@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "susolv/batch.h"
+#include "susolv/portfolio.h"
+#include "susolv/timing.h"
+
+/**
+ * latency of the plain search vs. the portfolio on a hard set.
+ * "portfolio" is measured for real, so it depends on how many cores this machine has.
+ * "projected" is what the portfolio would do with a core per search: the plain phase, plus
+ * the fastest of the seeded searches, each timed on its own.
+ *
+ * usage: susolv_bench_portfolio [puzzles] [workers] [node threshold]
+ */
+
+struct Percentiles {
+    int64_t p50, p99, max;
+};
+
+static Percentiles percentiles(std::vector<int64_t> ns) {
+    std::sort(ns.begin(), ns.end());
+    // nearest rank
+    auto at = [&ns](double p) { return ns[static_cast<size_t>(std::ceil(p * ns.size())) - 1]; };
+    return { at(0.50), at(0.99), ns.back() };
+}
+
+static void report(const char* name, const std::vector<int64_t>& ns) {
+    Percentiles p = percentiles(ns);
+    std::cout << name << "\tp50 " << p.p50 / 1000 << "us\tp99 " << p.p99 / 1000 << "us\tmax " << p.max / 1000 << "us\n";
+}
+
+int main(int argc, char** argv) {
+    const char* fname = argc > 1 ? argv[1] : SUSOLV_BOARDS_DIR "hard.txt";
+    PortfolioOptions options;
+    options.workers = argc > 2 ? std::stoul(argv[2]) : 4;
+    options.nodeThreshold = argc > 3 ? std::stoull(argv[3]) : 20'000;
+
+    std::vector<Board> boards = loadPackedBoards(fname);
+    std::vector<int64_t> plainNs, portfolioNs, projectedNs;
+    size_t raced = 0;
+
+    for (const Board& board : boards) {
+        auto plain = withTime([&]() { return solve(board, SolveOptions{}); });
+        plainNs.push_back(toNanos(plain.elapsed));
+
+        auto portfolio = withTime([&]() { return solvePortfolio(board, options); });
+        portfolioNs.push_back(toNanos(portfolio.elapsed));
+
+        if (plain.result.stats.nodes <= options.nodeThreshold) {
+            projectedNs.push_back(toNanos(plain.elapsed));
+            continue;
+        }
+
+        ++raced;
+        SolveOptions head;
+        head.nodeBudget = options.nodeThreshold;
+        int64_t fastest = INT64_MAX;
+        const int64_t headNs = toNanos(withTime([&]() { return solve(board, head); }).elapsed);
+        for (unsigned i = 0; i < options.workers; ++i) {
+            SolveOptions seeded;
+            seeded.seed = options.seed + i;
+            fastest = std::min<int64_t>(fastest, toNanos(withTime([&]() { return solve(board, seeded); }).elapsed));
+        }
+        projectedNs.push_back(headNs + fastest);
+    }
+
+    std::cout << boards.size() << " puzzles, " << raced << " past the " << options.nodeThreshold << " node threshold, "
+              << options.workers << " workers on " << std::thread::hardware_concurrency() << " cores\n";
+    report("plain    ", plainNs);
+    report("portfolio", portfolioNs);
+    report("projected", projectedNs);
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "susolv/batch.h"
+#include "susolv/board.h"
+#include "susolv/euler96.h"
+#include "susolv/perfCounters.h"
+
+/**
+ * per kernel hardware counters over a set of puzzles.
+ * usage: susolv_profile [puzzles]   (euler96 format, or one packed puzzle per line)
+ */
+
+static std::vector<Board> loadAny(const char* fname) {
+    std::ifstream f(fname);
+    std::string first;
+    std::getline(f, first);
+    return first.rfind("Grid", 0) == 0 ? loadEuler96(fname) : loadPackedBoards(fname);
+}
+
+// value / by, or n/a when there's nothing to divide by (no calls, no puzzles, cycles that didn't count)
+static void printRatio(double value, double by) {
+    if (by == 0) {
+        std::cout << "n/a\n";
+    }
+    else {
+        std::cout << value / by << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* fname = argc > 1 ? argv[1] : SUSOLV_BOARDS_DIR "euler96-all.txt";
+    std::vector<Board> boards = loadAny(fname);
+
+    KernelProfile profile;
+    SolveOptions options;
+    options.profile = &profile;
+
+    for (const Board& board : boards) {
+        solve(board, options);
+    }
+
+    const double puzzles = static_cast<double>(boards.size());
+    std::cout << boards.size() << " puzzles from " << fname << "\n";
+
+    if (!profile.group.available()) {
+        std::cout << "hardware counters unavailable: " << profile.group.unavailableReason() << "\n";
+        std::cout << "wall time only\n\n";
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (size_t k = 0; k < PROFILED_KERNEL_COUNT; ++k) {
+        const ProfiledKernel kernel = static_cast<ProfiledKernel>(k);
+        const KernelProfile::Totals& totals = profile[kernel];
+        if (totals.calls == 0) {
+            continue;
+        }
+
+        auto counter = [&totals](PerfCounter c) {
+            return static_cast<double>(totals.counters.values[static_cast<size_t>(c)]);
+        };
+
+        std::cout << profiledKernelName(kernel) << "\n";
+        const double calls = static_cast<double>(totals.calls);
+        std::cout << "  calls/puzzle          ";
+        printRatio(calls, puzzles);
+        std::cout << "  ns/call               ";
+        printRatio(static_cast<double>(totals.nanos), calls);
+
+        if (profile.group.has(PerfCounter::cycles) && profile.group.has(PerfCounter::instructions)) {
+            std::cout << "  cycles/call           ";
+            printRatio(counter(PerfCounter::cycles), calls);
+            std::cout << "  IPC                   ";
+            printRatio(counter(PerfCounter::instructions), counter(PerfCounter::cycles));
+        }
+
+        if (!profile.group.available()) {
+            continue;
+        }
+
+        for (PerfCounter c : { PerfCounter::branchMisses, PerfCounter::l1dMisses, PerfCounter::llcMisses }) {
+            std::cout << "  " << std::left << std::setw(22) << (std::string(perfCounterName(c)) + "/puzzle") << std::right;
+            if (profile.group.has(c)) {
+                printRatio(counter(c), puzzles);
+            }
+            else {
+                std::cout << "n/a\n";
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "susolv/multiGrid.h"
+#include "susolv/timing.h"
+
+/**
+ * the samurai set (boards/samurai.txt unless given), solved with grids propagated one after the other,
+ * then in parallel on GridWorkers of a few sizes. best of ROUNDS over the whole set, plus per puzzle
+ * node counts from the serial run.
+ */
+
+static constexpr int ROUNDS = 5;
+
+int main(int argc, char** argv) {
+    const char* fname = argc > 1 ? argv[1] : SUSOLV_BOARDS_DIR "samurai.txt";
+    const std::vector<SamuraiBoard> boards = loadSamuraiBoards(fname);
+
+    std::vector<SamuraiBoard> stack;
+    SamuraiBoard solved(SAMURAI_LAYOUT);
+
+    auto run = [&](const MultiGridOptions& options, SolveStats& stats) {
+        int64_t bestNs = INT64_MAX;
+        for (int round = 0; round < ROUNDS; ++round) {
+            stats = {};
+            bestNs = std::min<int64_t>(bestNs, toNanos(withTime([&]() {
+                size_t count = 0;
+                for (const SamuraiBoard& board : boards) {
+                    count += solveInto(board, solved, stack, options, stats) == SolveStatus::solved;
+                }
+                return count;
+            }).elapsed));
+        }
+        return bestNs;
+    };
+
+    SolveStats serialStats;
+    const int64_t serialNs = run(MultiGridOptions{}, serialStats);
+
+    std::vector<uint64_t> nodes;
+    for (const SamuraiBoard& board : boards) {
+        SolveStats stats;
+        solveInto(board, solved, stack, MultiGridOptions{}, stats);
+        nodes.push_back(stats.nodes);
+    }
+    std::sort(nodes.begin(), nodes.end());
+
+    std::cout << boards.size() << " samurai puzzles, best of " << ROUNDS << "\n";
+    std::cout << "nodes/puzzle: min " << nodes.front() << ", median " << nodes[nodes.size() / 2] << ", max " << nodes.back()
+        << ", max stack " << serialStats.maxQueue << "\n\n";
+    std::cout << "threads  us/puzzle  ns/node\n";
+    std::cout << "serial   " << serialNs / 1000 / static_cast<int64_t>(boards.size()) << "        "
+        << serialNs / static_cast<int64_t>(serialStats.nodes) << "\n";
+
+    for (unsigned threads : { 2u, 3u, 5u }) {
+        GridWorkers workers(threads);
+        MultiGridOptions options;
+        options.workers = &workers;
+        SolveStats stats;
+        const int64_t ns = run(options, stats);
+        std::cout << threads << "        " << ns / 1000 / static_cast<int64_t>(boards.size()) << "        "
+            << ns / static_cast<int64_t>(stats.nodes) << "\n";
+    }
+
+    return 0;
+}
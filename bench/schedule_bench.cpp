@@ -0,0 +1,284 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "susolv/batch.h"
+#include "susolv/batchRunner.h"
+#include "susolv/euler96.h"
+#include "susolv/schedule.h"
+#include "susolv/timing.h"
+
+/**
+ * what the longest-predicted-first order buys on a mixed batch: euler96, then 17clue, then hard.txt.
+ * every puzzle is solved on one thread first (best of ROUNDS per puzzle) for its cost, and those costs
+ * replayed through listScheduleMakespan for a few worker counts, in input order, shuffled, longest
+ * predicted first, and longest actually first (the best a perfect predictor could do with this greedy).
+ * the replay is what to look at on a machine with fewer cores than workers; the measured wall time of
+ * solveScheduled on hardware_concurrency workers follows.
+ * then runBatch, on the batch repeated REPEATS times so it's longer than its read-ahead window: replayed
+ * with that window (and, for comparison, cut into fixed chunks that each wait for their slowest puzzle),
+ * and measured on 1 and hardware_concurrency workers (at least 2, to show the pool's own overhead).
+ * last, how well the prediction ranks the puzzles' actual node counts, for both engines.
+ */
+
+static constexpr int ROUNDS = 3;
+static constexpr int REPEATS = 5;
+static constexpr size_t WINDOW_PER_WORKER = 64; // as in runBatch
+
+namespace {
+
+std::vector<double> ranks(const std::vector<double>& values) {
+    std::vector<size_t> order(values.size());
+    std::iota(order.begin(), order.end(), size_t{ 0 });
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return values[a] < values[b]; });
+
+    // ties share their mean rank
+    std::vector<double> rank(values.size());
+    for (size_t i = 0; i < order.size();) {
+        size_t j = i;
+        while (j < order.size() && values[order[j]] == values[order[i]]) {
+            ++j;
+        }
+        for (size_t k = i; k < j; ++k) {
+            rank[order[k]] = (i + j - 1) / 2.0;
+        }
+        i = j;
+    }
+    return rank;
+}
+
+double pearson(const std::vector<double>& x, const std::vector<double>& y) {
+    const double n = static_cast<double>(x.size());
+    const double mx = std::accumulate(x.begin(), x.end(), 0.0) / n;
+    const double my = std::accumulate(y.begin(), y.end(), 0.0) / n;
+    double sxy = 0, sxx = 0, syy = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        sxy += (x[i] - mx) * (y[i] - my);
+        sxx += (x[i] - mx) * (x[i] - mx);
+        syy += (y[i] - my) * (y[i] - my);
+    }
+    return sxy / std::sqrt(sxx * syy);
+}
+
+std::vector<double> log2Of(const std::vector<double>& values) {
+    std::vector<double> logs;
+    for (double v : values) {
+        logs.push_back(std::log2(std::max(v, 1.0)));
+    }
+    return logs;
+}
+
+std::vector<size_t> descendingBy(const std::vector<double>& values) {
+    std::vector<size_t> order(values.size());
+    std::iota(order.begin(), order.end(), size_t{ 0 });
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return values[a] > values[b]; });
+    return order;
+}
+
+// runBatch's policy replayed: puzzles enter a window of `window` in input order, an idle worker takes the
+// pending one with the highest `priority` (lowest index on ties), and the window only moves on past
+// puzzles that are done, since output is written in input order
+double windowedMakespan(const std::vector<double>& costs, const std::vector<double>& priority, unsigned workers, size_t window) {
+    const size_t count = costs.size();
+    auto before = [&](size_t a, size_t b) { return priority[a] != priority[b] ? priority[a] < priority[b] : a > b; };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(before)> pending(before);
+    using Running = std::pair<double, size_t>; // finish time, puzzle
+    std::priority_queue<Running, std::vector<Running>, std::greater<Running>> running;
+    std::vector<bool> done(count);
+
+    double now = 0;
+    size_t head = 0, next = 0;
+    while (true) {
+        for (; next < count && next - head < window; ++next) {
+            pending.push(next);
+        }
+        while (running.size() < workers && !pending.empty()) {
+            running.push({ now + costs[pending.top()], pending.top() });
+            pending.pop();
+        }
+        if (running.empty()) {
+            return now;
+        }
+        now = running.top().first;
+        done[running.top().second] = true;
+        running.pop();
+        while (head < count && done[head]) {
+            ++head;
+        }
+    }
+}
+
+// the window above cut into fixed chunks instead, each scheduled longest predicted first and finished
+// before the next one starts
+double chunkedMakespan(const std::vector<double>& costs, const std::vector<double>& predicted, unsigned workers, size_t chunk) {
+    double makespan = 0;
+    for (size_t start = 0; start < costs.size(); start += chunk) {
+        const size_t end = std::min(costs.size(), start + chunk);
+        const std::vector<double> chunkCosts(costs.begin() + start, costs.begin() + end);
+        makespan += listScheduleMakespan(chunkCosts, descendingBy({ predicted.begin() + start, predicted.begin() + end }), workers);
+    }
+    return makespan;
+}
+
+} // namespace
+
+int main() {
+    std::vector<Board> boards = loadEuler96(SUSOLV_BOARDS_DIR "euler96-all.txt");
+    for (const char* fname : { SUSOLV_BOARDS_DIR "17clue.txt", SUSOLV_BOARDS_DIR "hard.txt" }) {
+        const std::vector<Board> more = loadPackedBoards(fname);
+        boards.insert(boards.end(), more.begin(), more.end());
+    }
+    const size_t count = boards.size();
+
+    std::vector<double> predicted(count);
+    const int64_t probeNs = toNanos(withTime([&]() {
+        for (size_t i = 0; i < count; ++i) {
+            predicted[i] = probePuzzle(boards[i]).predictedNodes;
+        }
+    }).elapsed);
+
+    std::vector<Board> solved;
+    ScheduleOptions serial;
+    serial.workers = 1;
+    serial.order = BatchOrder::input;
+    ScheduleReport report;
+
+    std::vector<double> costs(count, INFINITY);
+    for (int round = 0; round < ROUNDS; ++round) {
+        solveScheduled(boards, solved, serial, report);
+        for (size_t i = 0; i < count; ++i) {
+            costs[i] = std::min(costs[i], static_cast<double>(report.puzzles[i].ns));
+        }
+    }
+    std::vector<double> nodes(count);
+    for (size_t i = 0; i < count; ++i) {
+        nodes[i] = static_cast<double>(report.puzzles[i].nodes);
+    }
+
+    const double total = std::accumulate(costs.begin(), costs.end(), 0.0);
+    std::cout << count << " puzzles, " << std::fixed << std::setprecision(2) << total / 1e6 << "ms serial, probes "
+        << probeNs / 1e6 << "ms (" << 100.0 * probeNs / total << "%)\n\n";
+
+    std::vector<size_t> input(count);
+    std::iota(input.begin(), input.end(), size_t{ 0 });
+    std::vector<size_t> shuffled = input;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64(1));
+    const std::vector<size_t> lpt = descendingBy(predicted);
+    const std::vector<size_t> oracle = descendingBy(costs);
+
+    std::cout << "replayed makespan, ms (lower bound max(total / workers, longest puzzle))\n";
+    std::cout << "workers   input   shuffled   predicted   actual   bound   input/predicted\n";
+    for (unsigned workers : { 2u, 4u, 8u, 16u }) {
+        const double bound = std::max(total / workers, *std::max_element(costs.begin(), costs.end()));
+        const double inputMs = listScheduleMakespan(costs, input, workers);
+        const double predictedMs = listScheduleMakespan(costs, lpt, workers);
+        std::cout << std::setw(7) << workers
+            << std::setw(8) << inputMs / 1e6
+            << std::setw(11) << listScheduleMakespan(costs, shuffled, workers) / 1e6
+            << std::setw(12) << predictedMs / 1e6
+            << std::setw(9) << listScheduleMakespan(costs, oracle, workers) / 1e6
+            << std::setw(8) << bound / 1e6
+            << std::setw(17) << inputMs / predictedMs << "x\n";
+    }
+
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "\nmeasured on " << threads << " workers, best of " << ROUNDS << ", ms\n";
+    for (BatchOrder order : { BatchOrder::input, BatchOrder::longestPredictedFirst }) {
+        ScheduleOptions options;
+        options.workers = threads;
+        options.order = order;
+        int64_t best = INT64_MAX;
+        for (int round = 0; round < ROUNDS; ++round) {
+            solveScheduled(boards, solved, options, report);
+            best = std::min(best, report.probeNs + report.makespanNs);
+        }
+        std::cout << (order == BatchOrder::input ? "  input       " : "  predicted   ") << best / 1e6 << "\n";
+    }
+
+    std::vector<double> repeatedCosts, repeatedPredicted;
+    for (int i = 0; i < REPEATS; ++i) {
+        repeatedCosts.insert(repeatedCosts.end(), costs.begin(), costs.end());
+        repeatedPredicted.insert(repeatedPredicted.end(), predicted.begin(), predicted.end());
+    }
+    const std::vector<double> inputPriority(repeatedCosts.size()); // all equal: oldest first
+    const double repeatedTotal = total * REPEATS;
+
+    std::cout << "\nrunBatch on " << repeatedCosts.size() << " puzzles (the batch " << REPEATS << " times), replayed makespan, ms\n";
+    std::cout << "workers   window   chunked   windowed input   windowed predicted   whole batch predicted   bound\n";
+    for (unsigned workers : { 2u, 4u, 8u, 16u }) {
+        const size_t window = WINDOW_PER_WORKER * workers;
+        const double bound = std::max(repeatedTotal / workers, *std::max_element(costs.begin(), costs.end()));
+        std::cout << std::setw(7) << workers
+            << std::setw(9) << window
+            << std::setw(10) << chunkedMakespan(repeatedCosts, repeatedPredicted, workers, window) / 1e6
+            << std::setw(17) << windowedMakespan(repeatedCosts, inputPriority, workers, window) / 1e6
+            << std::setw(21) << windowedMakespan(repeatedCosts, repeatedPredicted, workers, window) / 1e6
+            << std::setw(24) << listScheduleMakespan(repeatedCosts, descendingBy(repeatedPredicted), workers) / 1e6
+            << std::setw(8) << bound / 1e6 << "\n";
+    }
+
+    {
+        namespace fs = std::filesystem;
+        const fs::path dir = fs::temp_directory_path() / "susolv_schedule_bench";
+        fs::create_directories(dir);
+        {
+            std::ofstream out(dir / "in.txt", std::ios::binary);
+            char line[BOARD_CELLS + 1];
+            line[BOARD_CELLS] = '\n';
+            for (int i = 0; i < REPEATS; ++i) {
+                for (const Board& board : boards) {
+                    writeBoard(board, line);
+                    out.write(line, sizeof(line));
+                }
+            }
+        }
+
+        std::cout << "\nrunBatch measured, best of " << ROUNDS << ", ms\n";
+        std::cout << "workers      input   predicted\n";
+        for (unsigned workers : { 1u, std::max(2u, threads) }) {
+            std::cout << std::setw(7) << workers;
+            for (BatchOrder order : { BatchOrder::input, BatchOrder::longestPredictedFirst }) {
+                BatchRunOptions options;
+                options.inputPath = (dir / "in.txt").string();
+                options.outputPath = (dir / "out.txt").string();
+                options.workers = workers;
+                options.order = order;
+                BatchRunStats stats;
+                int64_t best = INT64_MAX;
+                for (int round = 0; round < ROUNDS; ++round) {
+                    best = std::min<int64_t>(best, toNanos(withTime([&]() { return runBatch(options, stats); }).elapsed));
+                }
+                std::cout << std::setw(order == BatchOrder::input ? 11 : 12) << best / 1e6;
+            }
+            std::cout << "\n";
+        }
+        fs::remove_all(dir);
+    }
+
+    std::vector<double> bitboardNodes(count);
+    ScheduleOptions bitboard = serial;
+    bitboard.solve.engine = SolveEngine::bitboard;
+    solveScheduled(boards, solved, bitboard, report);
+    for (size_t i = 0; i < count; ++i) {
+        bitboardNodes[i] = static_cast<double>(report.puzzles[i].nodes);
+    }
+
+    std::cout << "\nprediction against actual nodes   spearman   pearson (log2)\n";
+    const std::vector<double> logPredicted = log2Of(predicted);
+    std::cout << "  cellMajor                       " << std::setw(8) << pearson(ranks(predicted), ranks(nodes))
+        << std::setw(11) << pearson(logPredicted, log2Of(nodes)) << "\n";
+    std::cout << "  bitboard                        " << std::setw(8) << pearson(ranks(predicted), ranks(bitboardNodes))
+        << std::setw(11) << pearson(logPredicted, log2Of(bitboardNodes)) << "\n";
+    std::cout << "  (time, cellMajor)               " << std::setw(8) << pearson(ranks(predicted), ranks(costs))
+        << std::setw(11) << pearson(logPredicted, log2Of(costs)) << "\n";
+    return 0;
+}
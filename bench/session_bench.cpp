@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "susolv/board.h"
+#include "susolv/euler96.h"
+#include "susolv/solverSession.h"
+#include "susolv/timing.h"
+
+/**
+ * per edit latency of a SolverSession vs solving the edited grid from scratch.
+ * each euler96 puzzle gets the same scripted edits:
+ *   remove a random clue, put it back, fill a random empty cell with its solution value,
+ *   fill another with a wrong candidate (re-solve or contradiction), take that back out
+ */
+
+static constexpr int ROUNDS = 20;
+
+enum Edit { removeClue, restoreClue, fillRight, fillWrong, undoWrong, EDIT_COUNT };
+static const char* EDIT_NAMES[EDIT_COUNT] = { "remove clue", "restore clue", "fill (right)", "fill (wrong)", "undo wrong" };
+
+int main(int argc, char** argv) {
+    const char* fname = argc > 1 ? argv[1] : SUSOLV_BOARDS_DIR "euler96-all.txt";
+    std::vector<Board> boards = loadEuler96(fname);
+
+    int64_t sessionNs[EDIT_COUNT] = {};
+    int64_t scratchNs[EDIT_COUNT] = {};
+    uint64_t reused[EDIT_COUNT] = {};
+    uint64_t edits[EDIT_COUNT] = {};
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        std::mt19937 rng(round);
+
+        for (const Board& puzzle : boards) {
+            SolverSession session(puzzle);
+            const Board solution = *session.solution();
+
+            std::vector<uint8_t> clues, blanks;
+            for (uint8_t i = 0; i < 81; ++i) {
+                (puzzle.isSolved(i) ? clues : blanks).push_back(i);
+            }
+            std::shuffle(clues.begin(), clues.end(), rng);
+            std::shuffle(blanks.begin(), blanks.end(), rng);
+
+            const uint8_t clue = clues[0];
+            const uint8_t right = blanks[0];
+            const uint8_t wrongCell = blanks[1];
+            const uint8_t wrongValue = solution.getSolvedValue(wrongCell) % 9 + 1;
+
+            auto edit = [&](Edit kind, auto&& apply) {
+                auto timed = withTime(apply);
+                sessionNs[kind] += toNanos(timed.elapsed);
+                reused[kind] += timed.result.reused;
+                edits[kind] += 1;
+                scratchNs[kind] += toNanos(withTime([&]() { return solve(session.clues(), SolveOptions{}); }).elapsed);
+            };
+
+            edit(removeClue, [&]() { return session.removeClue(clue); });
+            edit(restoreClue, [&]() { return session.placeClue(clue, puzzle.getSolvedValue(clue)); });
+            edit(fillRight, [&]() { return session.placeClue(right, solution.getSolvedValue(right)); });
+            edit(fillWrong, [&]() { return session.placeClue(wrongCell, wrongValue); });
+            edit(undoWrong, [&]() { return session.removeClue(wrongCell); });
+        }
+    }
+
+    std::cout << boards.size() << " puzzles x " << ROUNDS << " rounds\n";
+    std::cout << "edit\t\tsession ns\tfull solve ns\treused\n";
+    for (int kind = 0; kind < EDIT_COUNT; ++kind) {
+        std::cout << EDIT_NAMES[kind] << "\t" << sessionNs[kind] / edits[kind] << "\t\t" << scratchNs[kind] / edits[kind]
+                  << "\t\t" << 100 * reused[kind] / edits[kind] << "%\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "susolv/board.h"
+#include "susolv/euler96.h"
+#include "susolv/timing.h"
+#include "susolv/variantBoard.h"
+
+/**
+ * solve time per constraint layout.
+ * euler96 goes through both Board and VariantBoard<StandardLayout>, which is the cost of the generic unit tables.
+ * there are no X / windoku / jigsaw sets in boards/, so those puzzles are made here: fill an empty grid by
+ * depth first search with a seeded value order, then keep CLUES random cells. they aren't unique puzzles, just solvable ones.
+ */
+
+static constexpr int PUZZLES = 50;
+static constexpr int CLUES = 30;
+static constexpr int ROUNDS = 20;
+
+template<typename Layout>
+static bool fill(VariantBoard<Layout>& board, std::mt19937& rng) {
+    Board::SimpleSolveResult result = board.simpleSolve();
+    if (result.solved || result.invalid) {
+        return result.solved;
+    }
+
+    uint8_t values[9];
+    uint8_t count = 0;
+    for (uint16_t candidates = board.availableValuesForCell(result.bestIndex); candidates != 0; candidates &= candidates - 1) {
+        values[count++] = static_cast<uint8_t>(std::countr_zero(candidates));
+    }
+    std::shuffle(values, values + count, rng);
+
+    for (uint8_t i = 0; i < count; ++i) {
+        VariantBoard<Layout> next = board;
+        next.setSolved(result.bestIndex, values[i]);
+        if (fill(next, rng)) {
+            board = next;
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Layout>
+static std::vector<VariantBoard<Layout>> makePuzzles(Layout layout, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<VariantBoard<Layout>> puzzles;
+
+    while (puzzles.size() < PUZZLES) {
+        VariantBoard<Layout> grid(layout);
+        for (uint8_t i = 0; i < 81; ++i) {
+            grid.setUnknown(i);
+        }
+        grid.fullComputeTakenVals();
+        if (!fill(grid, rng)) {
+            continue;
+        }
+
+        uint8_t order[81];
+        for (uint8_t i = 0; i < 81; ++i) order[i] = i;
+        std::shuffle(order, order + 81, rng);
+
+        VariantBoard<Layout> puzzle(layout);
+        for (uint8_t i = 0; i < 81; ++i) {
+            puzzle.setUnknown(order[i]);
+            if (i < CLUES) {
+                puzzle.setSolved(order[i], grid.getSolvedValue(order[i]) - 1);
+            }
+        }
+        puzzles.push_back(puzzle);
+    }
+
+    return puzzles;
+}
+
+template<typename B>
+static void run(const char* name, const std::vector<B>& puzzles) {
+    int64_t best = INT64_MAX;
+    size_t solvedCount = 0;
+    for (int round = 0; round < ROUNDS; ++round) {
+        auto timed = withTime([&puzzles]() {
+            size_t n = 0;
+            for (const B& puzzle : puzzles) n += solve(puzzle).has_value();
+            return n;
+        });
+        best = std::min<int64_t>(best, toNanos(timed.elapsed));
+        solvedCount = timed.result;
+    }
+    std::cout << name << "\t" << solvedCount << "/" << puzzles.size() << " solved\t" << best / static_cast<int64_t>(puzzles.size()) << "ns/puzzle\n";
+}
+
+int main(int argc, char** argv) {
+    const char* euler = argc > 1 ? argv[1] : SUSOLV_BOARDS_DIR "euler96-all.txt";
+    const char* regions = argc > 2 ? argv[2] : SUSOLV_BOARDS_DIR "jigsaw-regions.txt";
+
+    std::vector<Board> boards = loadEuler96(euler);
+    std::vector<VariantBoard<StandardLayout>> standard;
+    for (const Board& board : boards) {
+        VariantBoard<StandardLayout> variant;
+        for (uint8_t i = 0; i < 81; ++i) {
+            variant.setUnknown(i);
+            if (board.isSolved(i)) {
+                variant.setSolved(i, board.getSolvedValue(i) - 1);
+            }
+        }
+        standard.push_back(variant);
+    }
+
+    JigsawLayout::Table jigsawTable;
+    if (!loadJigsawTable(regions, jigsawTable)) {
+        std::cout << "Can't load jigsaw regions from " << regions << std::endl;
+        return 1;
+    }
+
+    std::cout << "best of " << ROUNDS << ", generated sets have " << PUZZLES << " puzzles of " << CLUES << " clues\n";
+    run("euler96  Board        ", boards);
+    run("euler96  Standard     ", standard);
+    run("generated Standard    ", makePuzzles(StandardLayout{}, 1));
+    run("generated Diagonal (X)", makePuzzles(DiagonalLayout{}, 2));
+    run("generated Hyper       ", makePuzzles(HyperLayout{}, 3));
+    run("generated Jigsaw      ", makePuzzles(JigsawLayout(jigsawTable), 4));
+
+    return 0;
+}
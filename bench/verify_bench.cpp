@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "susolv/batch.h"
+#include "susolv/board.h"
+#include "susolv/euler96.h"
+#include "susolv/timing.h"
+#include "susolv/verify.h"
+
+/**
+ * throughput of verifyBatch against verifySolutionScalar and against grading by solving the puzzle and
+ * comparing grids (cell-major and bitboard engines), per puzzle set.
+ * each set's solutions are repeated into a POOL_SIZE pool of (puzzle, grid) pairs, a quarter of them
+ * damaged by swapping two non-clue cells; solve-and-compare runs over the set once per round.
+ */
+
+static constexpr size_t POOL_SIZE = 1 << 16;
+static constexpr int ROUNDS = 3;
+
+template<typename F>
+static int64_t best(F&& f) {
+    int64_t bestNs = INT64_MAX;
+    for (int round = 0; round < ROUNDS; ++round) {
+        bestNs = std::min<int64_t>(bestNs, toNanos(withTime(f).elapsed));
+    }
+    return bestNs;
+}
+
+static void benchSet(const char* name, const std::vector<Board>& boards) {
+    std::vector<char> puzzles(POOL_SIZE * BOARD_CELLS);
+    std::vector<char> grids(POOL_SIZE * BOARD_CELLS);
+    std::vector<VerifyStatus> statuses(POOL_SIZE);
+
+    std::vector<std::string> solutions;
+    for (const Board& board : boards) {
+        std::string solution(BOARD_CELLS, '0');
+        writeBoard(*solve(board), solution.data());
+        solutions.push_back(solution);
+    }
+
+    for (size_t i = 0; i < POOL_SIZE; ++i) {
+        char* puzzle = &puzzles[i * BOARD_CELLS];
+        char* grid = &grids[i * BOARD_CELLS];
+        writeBoard(boards[i % boards.size()], puzzle);
+        std::memcpy(grid, solutions[i % boards.size()].data(), BOARD_CELLS);
+
+        if (i % 4 == 3) {
+            size_t a = (i * 7) % BOARD_CELLS;
+            while (puzzle[a] != '0') a = (a + 1) % BOARD_CELLS;
+            size_t b = (a + 1) % BOARD_CELLS;
+            while (puzzle[b] != '0' || grid[b] == grid[a]) b = (b + 1) % BOARD_CELLS;
+            std::swap(grid[a], grid[b]);
+        }
+    }
+
+    const int64_t vectorNs = best([&]() {
+        return verifyBatch(puzzles.data(), grids.data(), statuses.data(), POOL_SIZE);
+    });
+    const int64_t scalarNs = best([&]() {
+        size_t valid = 0;
+        for (size_t i = 0; i < POOL_SIZE; ++i) {
+            valid += verifySolutionScalar(&puzzles[i * BOARD_CELLS], &grids[i * BOARD_CELLS]) == VerifyStatus::valid;
+        }
+        return valid;
+    });
+
+    const size_t valid = verifyBatch(puzzles.data(), grids.data(), nullptr, POOL_SIZE);
+
+    auto solveAndCompare = [&](SolveEngine engine) {
+        SolveOptions options;
+        options.engine = engine;
+        std::deque<Board> queue;
+        Board solved;
+        char solution[BOARD_CELLS];
+
+        return best([&]() {
+            size_t matches = 0;
+            for (size_t i = 0; i < boards.size(); ++i) {
+                SolveStats stats;
+                if (solveInto(boards[i], solved, queue, options, stats) == SolveStatus::solved) {
+                    writeBoard(solved, solution);
+                    matches += std::memcmp(solution, &grids[i * BOARD_CELLS], BOARD_CELLS) == 0;
+                }
+            }
+            return matches;
+        }) / static_cast<int64_t>(boards.size());
+    };
+
+    const int64_t cellMajorNs = solveAndCompare(SolveEngine::cellMajor);
+    const int64_t bitboardNs = solveAndCompare(SolveEngine::bitboard);
+
+    std::cout << name << ": " << boards.size() << " puzzles, " << valid << "/" << POOL_SIZE << " grids valid\n";
+    std::cout << "  verifyBatch            " << static_cast<double>(vectorNs) / POOL_SIZE << " ns/grid\n";
+    std::cout << "  verifySolutionScalar   " << static_cast<double>(scalarNs) / POOL_SIZE << " ns/grid\n";
+    std::cout << "  solve+compare cellMajor " << cellMajorNs << " ns/grid ("
+        << static_cast<double>(cellMajorNs) * POOL_SIZE / vectorNs << "x verifyBatch)\n";
+    std::cout << "  solve+compare bitboard  " << bitboardNs << " ns/grid ("
+        << static_cast<double>(bitboardNs) * POOL_SIZE / vectorNs << "x verifyBatch)\n";
+}
+
+int main() {
+    benchSet("euler96", loadEuler96(SUSOLV_BOARDS_DIR "euler96-all.txt"));
+    benchSet("17clue", loadPackedBoards(SUSOLV_BOARDS_DIR "17clue.txt"));
+    benchSet("hard", loadPackedBoards(SUSOLV_BOARDS_DIR "hard.txt"));
+    return 0;
+}
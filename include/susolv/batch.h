@@ -0,0 +1,40 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "susolv/board.h"
+
+// a packed puzzle or solution is 81 bytes, row-major, no separators or terminator.
+// puzzles use '1'-'9' for clues and '0' or '.' for unknowns; solutions are always '1'-'9'.
+inline constexpr size_t BOARD_CELLS = 81;
+
+enum class BatchStatus : uint8_t {
+    solved = 0,
+    unsolvable = 1,
+    invalidInput = 2, // a byte outside [0-9.], or two equal clues in the same row/col/quad
+};
+
+// false if `cells` isn't a well formed puzzle, in which case `board` is left partially written
+bool parseBoard(const char* cells, Board& board);
+
+/**
+ * loads a file of packed puzzles, one per line; blank lines and lines starting with '#' are skipped.
+ * a malformed line is reported and skipped.
+ */
+std::vector<Board> loadPackedBoards(const char* fname);
+
+// unsolved cells are written as '0'
+void writeBoard(const Board& board, char* cells);
+
+/**
+ * solves `count` packed puzzles from `puzzles` into `solutions` (both count * 81 bytes).
+ * the solution slot of a puzzle that isn't solved is filled with '0'.
+ * `statuses` is optional; if non-null it gets one entry per puzzle.
+ * returns the number of puzzles solved.
+ */
+size_t solveBatch(const char* puzzles, char* solutions, BatchStatus* statuses, size_t count);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <cstdint>
+#include <string>
+
+#include "susolv/board.h"
+#include "susolv/schedule.h"
+
+struct BatchRunOptions {
+    std::string inputPath;      // one packed puzzle per line, as loadPackedBoards
+    std::string outputPath;     // one line per puzzle, in input order: the solution, or 81 '0's
+    std::string checkpointPath; // empty: no checkpoints, and always start from scratch
+
+    uint64_t checkpointEvery = 10'000; // puzzles; 0 never checkpoints
+    bool sync = false;                 // fsync output and checkpoint too, to survive more than the process dying
+
+    SolveOptions solve{};
+
+    // solver threads; above 1, puzzles are handed to a SchedulePool as they're read, up to 64 per worker
+    // ahead of the output, and solved in `order` within that window (solve.profile / solve.trace are
+    // ignored, see ScheduleOptions). output is in input order either way
+    unsigned workers = 1;
+    BatchOrder order = BatchOrder::longestPredictedFirst;
+
+    // stop (without a final checkpoint, like a kill would) once this many puzzles are done in this run
+    uint64_t stopAfter = UINT64_MAX;
+};
+
+// the running totals kept in the checkpoint
+struct BatchRunStats {
+    uint64_t inputOffset = 0;  // bytes of input consumed
+    uint64_t outputOffset = 0; // bytes of output written
+    uint64_t completed = 0;
+    uint64_t solved = 0;
+    uint64_t unsolvable = 0;
+    uint64_t invalid = 0;      // lines that aren't puzzles, or clues that clash
+    uint64_t timedOut = 0;     // timed out or cancelled under options.solve
+    uint64_t nodes = 0;
+    uint64_t inputSize = 0;    // the input this run belongs to; a checkpoint for another is refused
+    std::string inputPath;     // (canonical)
+    bool resumed = false;      // picked up from a checkpoint rather than starting fresh
+};
+
+/**
+ * solves every puzzle of the input into the output, appending as it goes, and every `checkpointEvery`
+ * puzzles flushes the output and atomically replaces the checkpoint (write to .tmp, rename).
+ * if a checkpoint exists it's resumed from: output past the checkpointed offset (written after it, before
+ * the process died) is cut off, and the input is read from the checkpointed offset on.
+ * false (with a message on stderr) if a file can't be opened, the checkpoint can't be read or written,
+ * or the checkpoint is for a different input (another path, or the same path at another size).
+ */
+bool runBatch(const BatchRunOptions& options, BatchRunStats& stats);
+
+bool readCheckpoint(const std::string& path, BatchRunStats& stats);
+bool writeCheckpoint(const std::string& path, const BatchRunStats& stats, bool sync);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef BIT_BOARD_H
+#define BIT_BOARD_H
+
+#include <cstdint>
+
+#include "susolv/board.h"
+
+/**
+ * digit-major grid: for each digit, a plane of the cells it can still go in, as three 27 bit bands
+ * (band b = rows 3b..3b+2, bit = 9 * row-in-band + col). naked singles come out of bit-sliced counts
+ * across the nine planes, and hidden singles out of per-unit masks on a plane, so a propagation pass
+ * is a few dozen band wide ands/ors instead of a gather per cell.
+ */
+class BitBoard {
+public:
+    static constexpr uint32_t BAND_MASK = (1u << 27) - 1;
+
+    uint32_t candidates[9][3]; // [digit][band]
+    uint32_t placed[9][3];     // [digit][band]
+    uint32_t unsolved[3];      // [band]
+
+    // false if the clues in `board` already clash
+    bool load(const Board& board);
+
+    // `this` must be fully solved; every cell of `board` is overwritten
+    void store(Board& board) const;
+
+    // digit is 0-8; false if `digit` can't go in `cellIndex` (any more)
+    bool place(uint8_t cellIndex, uint8_t digit);
+
+    struct PropagateResult {
+        bool invalid = false;
+        bool solved = false;
+        uint8_t bestIndex = 0xFF; // an unsolved cell with the fewest candidates, if neither
+    };
+
+    // naked and hidden singles until nothing changes
+    PropagateResult propagate();
+
+    uint16_t candidatesForCell(uint8_t cellIndex) const;
+};
+
+// the SolveEngine::bitboard side of solveInto; depth first, ignores options.seed and options.profile
+SolveStatus solveBitboard(const Board& board, Board& solved, const SolveOptions& options, SolveStats& stats);
+
+#endif
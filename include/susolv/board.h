@@ -2,9 +2,12 @@
 #define BOARD_H
 
 #include <bit>
+#include <chrono>
 #include <cstdint>
+#include <deque>
 #include <iostream>
 #include <optional>
+#include <stop_token>
 #include <string>
 #include <type_traits>
 #include <cassert>
@@ -158,6 +161,15 @@ public:
             }
         }
 
+        void setUnsolved(uint8_t index) {
+            if (index >= 64) {
+                b2 &= ~(static_cast<B2>(1) << static_cast<B2>(index - 64));
+            }
+            else {
+                b1 &= ~(static_cast<B1>(1) << static_cast<B1>(index));
+            }
+        }
+
         bool isSolved(uint8_t index) {
             if (index >= 64) {
                 return b2 & (static_cast<B2>(1) << static_cast<B2>(index - 64));
@@ -195,6 +207,8 @@ public:
     Board() = default;
     Board(const Board& rhs) = default;
     Board(Board&& rhs) = default;
+    Board& operator=(const Board& rhs) = default;
+    Board& operator=(Board&& rhs) = default;
 
     friend std::ostream& operator<<(std::ostream& out, const Board& board);
 
@@ -299,7 +313,7 @@ public:
         bool solved = false;
     };
 
-private:
+    // candidates for an unsolved cell under the current takenValues
     uint16_t availableValuesForCell(uint8_t index) const {
         const uint8_t row = cellIndexLookup.indexToRow[index];
         const uint8_t col = cellIndexLookup.indexToCol[index];
@@ -309,7 +323,6 @@ private:
         return available;
     }
 
-public:
     SimpleSolveResult simpleSolve() noexcept {
         SimpleSolveResult result;
         bool didChange;
@@ -422,7 +435,66 @@ static_assert(sizeof(Board) == 256, "Expected sizeof(Board) to be 256");
 static_assert(alignof(Board) == 256, "Expected alignof(Board) to be 256");
 static_assert(std::is_nothrow_move_constructible_v<Board>, "`Board` should be nothrow move constructible.");
 
+struct KernelProfile;
+class SearchTrace;
+
+enum class SolveStatus : uint8_t {
+    solved,
+    unsolvable,
+    timedOut,  // hit the deadline or the node budget
+    cancelled, // stop was requested on the stop token
+};
+
+enum class SolveEngine : uint8_t {
+    cellMajor, // Board: a uint16 candidate mask per cell, breadth first
+    bitboard,  // BitBoard: a 81 bit plane per digit, depth first (susolv/bitBoard.h)
+};
+
+// limits for a single solve; the defaults are "no limit"
+struct SolveOptions {
+    using clock = std::chrono::steady_clock;
+
+    // the deadline and stop token are polled once per CHECK_INTERVAL nodes, the budget on every node
+    static constexpr uint64_t CHECK_INTERVAL = 64;
+
+    clock::time_point deadline = clock::time_point::max();
+    uint64_t nodeBudget = UINT64_MAX;
+    std::stop_token stopToken{};
+
+    // 0 searches in the usual fixed order. anything else seeds a random tie-break between equally
+    // constrained branch cells, and a random order for the values tried in the chosen cell
+    uint64_t seed = 0;
+
+    // if set, per kernel hardware counters and timings are added to it (see susolv/perfCounters.h)
+    KernelProfile* profile = nullptr;
+
+    // if set (and the build has SUSOLV_TRACE on), the search's events are recorded to it (see susolv/searchTrace.h)
+    SearchTrace* trace = nullptr;
+
+    // seed, profile and trace only apply to the cellMajor engine
+    SolveEngine engine = SolveEngine::cellMajor;
+};
+
+struct SolveStats {
+    uint64_t nodes = 0;    // boards taken off the work queue and run through simpleSolve
+    size_t maxQueue = 0;   // high water mark of the work queue
+};
+
+struct SolveResult {
+    SolveStatus status = SolveStatus::unsolvable;
+    SolveStats stats{};
+    Board board; // only meaningful if status == solved
+};
+
 Board loadBoard(const char* fname);
 std::optional<Board> solve(const Board& board);
+SolveResult solve(const Board& board, const SolveOptions& options);
+
+// `solve` without the optional; `boards` is the work queue and is cleared on entry,
+// so callers solving many boards can hand in the same one and keep its storage around
+bool solveInto(const Board& board, Board& solved, std::deque<Board>& boards);
+
+// as above, honoring `options`. `stats` is accumulated into, not reset; the node budget only counts this call's nodes
+SolveStatus solveInto(const Board& board, Board& solved, std::deque<Board>& boards, const SolveOptions& options, SolveStats& stats);
 
 #endif // BOARD_H
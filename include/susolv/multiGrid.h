@@ -0,0 +1,423 @@
+#ifndef MULTI_GRID_H
+#define MULTI_GRID_H
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "susolv/board.h"
+
+/**
+ * several standard grids on one canvas, overlapping in whole quads. samurai is five of them, the center
+ * grid sharing each of its corner quads with one of the outer four:
+ *
+ *   0 . 1      grid 0 at (0, 0), 1 at (0, 12), 2 at (6, 6), 3 at (12, 0), 4 at (12, 12)
+ *   . 2 .      on a 21x21 canvas
+ *   3 . 4
+ *
+ * every grid is a plain Board. a cell in an overlap exists once in each of its two grids, and the copies
+ * are kept in step: solving one solves the other, and its candidates are what both grids allow.
+ */
+
+template<size_t GridCount>
+struct MultiGridLayout {
+    static constexpr size_t GRID_COUNT = GridCount;
+    static constexpr uint8_t NO_TWIN = 0xFF;
+
+    // the other copy of a cell in an overlap; grid == NO_TWIN if the cell is in one grid only
+    struct Twin {
+        uint8_t grid = NO_TWIN;
+        uint8_t cell = 0;
+    };
+
+    uint8_t height = 0;
+    uint8_t width = 0;
+    uint8_t origin[GridCount][2]{}; // [grid][row, col] of the grid's top left cell on the canvas
+    Twin twins[GridCount][81]{};
+
+    // throws (so fails to compile, for a constexpr layout) unless grids overlap in whole quads, at most two to a cell
+    constexpr explicit MultiGridLayout(const uint8_t (&origins)[GridCount][2]) {
+        for (size_t grid = 0; grid < GridCount; ++grid) {
+            for (Twin& twin : twins[grid]) {
+                twin = {};
+            }
+            origin[grid][0] = origins[grid][0];
+            origin[grid][1] = origins[grid][1];
+            height = origin[grid][0] + 9 > height ? static_cast<uint8_t>(origin[grid][0] + 9) : height;
+            width = origin[grid][1] + 9 > width ? static_cast<uint8_t>(origin[grid][1] + 9) : width;
+        }
+
+        for (size_t a = 0; a < GridCount; ++a) {
+            for (size_t b = a + 1; b < GridCount; ++b) {
+                const int dy = origin[b][0] - origin[a][0];
+                const int dx = origin[b][1] - origin[a][1];
+                if (dy <= -9 || dy >= 9 || dx <= -9 || dx >= 9) {
+                    continue;
+                }
+                if (dy % 3 != 0 || dx % 3 != 0) {
+                    throw "grids overlap in part of a quad";
+                }
+
+                for (int cell = 0; cell < 81; ++cell) {
+                    const int y = cell / 9 - dy;
+                    const int x = cell % 9 - dx;
+                    if (y < 0 || y >= 9 || x < 0 || x >= 9) {
+                        continue;
+                    }
+                    const int other = y * 9 + x;
+                    if (twins[a][cell].grid != NO_TWIN || twins[b][other].grid != NO_TWIN) {
+                        throw "a cell is in more than two grids";
+                    }
+                    twins[a][cell] = { static_cast<uint8_t>(b), static_cast<uint8_t>(other) };
+                    twins[b][other] = { static_cast<uint8_t>(a), static_cast<uint8_t>(cell) };
+                }
+            }
+        }
+    }
+
+    constexpr int canvasRow(size_t grid, uint8_t cell) const {
+        return origin[grid][0] + cell / 9;
+    }
+
+    constexpr int canvasCol(size_t grid, uint8_t cell) const {
+        return origin[grid][1] + cell % 9;
+    }
+};
+
+inline constexpr MultiGridLayout<5> SAMURAI_LAYOUT{ { {0, 0}, {0, 12}, {6, 6}, {12, 0}, {12, 12} } };
+
+/**
+ * a fixed set of threads (the caller being one of them) for running one small job per grid, in parallel.
+ * run() is a barrier round trip either side of the jobs, so it only pays off if the jobs are big next to
+ * a wakeup; grids that each take a few hundred ns to propagate don't qualify on their own.
+ */
+class GridWorkers {
+public:
+    explicit GridWorkers(unsigned threads);
+    ~GridWorkers();
+
+    GridWorkers(const GridWorkers&) = delete;
+    GridWorkers& operator=(const GridWorkers&) = delete;
+
+    unsigned threads() const { return static_cast<unsigned>(threads_.size()) + 1; }
+
+    // job(i) for every i in [0, count), spread over the threads; returns once all are done
+    void run(size_t count, const std::function<void(size_t)>& job);
+
+private:
+    void work();
+    void drain();
+
+    std::barrier<> start_;
+    std::barrier<> done_;
+    std::atomic<size_t> next_ = 0;
+    size_t count_ = 0;                                   // job_ and count_ are published by the start_ barrier
+    const std::function<void(size_t)>* job_ = nullptr;
+    std::atomic<bool> stopping_ = false;
+
+    // last, so that even without the explicit joins in ~GridWorkers the threads would go before what they use
+    std::vector<std::jthread> threads_;
+};
+
+struct MultiGridOptions {
+    // if set, grids are propagated on it in parallel; otherwise (the default, and the faster choice as far
+    // as measured) one after the other on the calling thread. on one core the parallel mode measured 2-5x
+    // slower than serial; susolv_bench_samurai shows whether more cores change that
+    GridWorkers* workers = nullptr;
+
+    // deadline / budget / stop token, as for solve(); seed, profile, trace and engine are ignored
+    SolveOptions limits{};
+};
+
+template<size_t GridCount>
+class MultiGrid {
+public:
+    using Layout = MultiGridLayout<GridCount>;
+
+    Board grids[GridCount];
+    const Layout* layout;
+
+    explicit MultiGrid(const Layout& _layout) : layout(&_layout) {
+        for (Board& grid : grids) {
+            for (uint8_t cell = 0; cell < 81; ++cell) {
+                grid.setUnknown(cell);
+            }
+            grid.fullComputeTakenVals();
+        }
+    }
+
+    bool isSolved(size_t grid, uint8_t cell) const noexcept {
+        return grids[grid].isSolved(cell);
+    }
+
+    // undefined behavior if cell is not solved
+    uint8_t getSolvedValue(size_t grid, uint8_t cell) const noexcept {
+        return grids[grid].getSolvedValue(cell);
+    }
+
+    // what the cell's own grid allows, and its twin's grid too if it's in an overlap
+    uint16_t availableValues(size_t grid, uint8_t cell) const noexcept {
+        const typename Layout::Twin twin = layout->twins[grid][cell];
+        uint16_t available = grids[grid].availableValuesForCell(cell);
+        if (twin.grid != Layout::NO_TWIN) {
+            available &= grids[twin.grid].availableValuesForCell(twin.cell);
+        }
+        return available;
+    }
+
+    // sets the cell and its twin, if any
+    void setSolved(size_t grid, uint8_t cell, uint8_t bitIndex) noexcept {
+        const typename Layout::Twin twin = layout->twins[grid][cell];
+        grids[grid].setSolved(cell, bitIndex);
+        if (twin.grid != Layout::NO_TWIN) {
+            grids[twin.grid].setSolved(twin.cell, bitIndex);
+        }
+    }
+
+    void fullComputeTakenVals() noexcept {
+        for (Board& grid : grids) {
+            grid.fullComputeTakenVals();
+        }
+    }
+
+    bool isFullySolved() const noexcept {
+        for (const Board& grid : grids) {
+            if (!grid.solvedIndices.boardIsFullySolved()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct PropagateResult {
+        uint8_t bestGrid = 0xFF;
+        uint8_t bestCell = 0xFF;
+        uint8_t bitCount = 0xFF;
+        bool invalid = false;
+        bool solved = false;
+    };
+
+    /**
+     * Board::simpleSolve on every grid that changed, then the overlaps: a value solved on one side is
+     * copied to the other, and a cell the two grids between them narrow to one value is solved in both.
+     * repeats until nothing changes, then picks the unsolved cell with the fewest candidates over all grids.
+     */
+    PropagateResult propagate(GridWorkers* workers = nullptr) noexcept {
+        PropagateResult result;
+        bool dirty[GridCount];
+        std::fill(dirty, dirty + GridCount, true);
+
+        while (true) {
+            Board::SimpleSolveResult gridResults[GridCount];
+
+            if (workers) {
+                size_t order[GridCount];
+                size_t count = 0;
+                for (size_t grid = 0; grid < GridCount; ++grid) {
+                    if (dirty[grid]) order[count++] = grid;
+                }
+                workers->run(count, [&](size_t i) { gridResults[order[i]] = grids[order[i]].simpleSolve(); });
+            }
+            else {
+                for (size_t grid = 0; grid < GridCount; ++grid) {
+                    if (dirty[grid]) gridResults[grid] = grids[grid].simpleSolve();
+                }
+            }
+
+            for (size_t grid = 0; grid < GridCount; ++grid) {
+                if (dirty[grid] && gridResults[grid].invalid) {
+                    result.invalid = true;
+                    return result;
+                }
+                dirty[grid] = false;
+            }
+
+            bool changed = false;
+            for (size_t grid = 0; grid < GridCount; ++grid) {
+                for (uint8_t cell = 0; cell < 81; ++cell) {
+                    const typename Layout::Twin twin = layout->twins[grid][cell];
+                    if (twin.grid == Layout::NO_TWIN || twin.grid < grid) {
+                        continue;
+                    }
+
+                    Board& a = grids[grid];
+                    Board& b = grids[twin.grid];
+                    const bool solvedA = a.isSolved(cell);
+                    const bool solvedB = b.isSolved(twin.cell);
+
+                    if (solvedA && solvedB) {
+                        if (a.getSolvedValue(cell) != b.getSolvedValue(twin.cell)) {
+                            result.invalid = true;
+                            return result;
+                        }
+                        continue;
+                    }
+
+                    uint16_t available = 0;
+                    if (solvedA) {
+                        available = b.availableValuesForCell(twin.cell) & (1 << (a.getSolvedValue(cell) - 1));
+                    }
+                    else if (solvedB) {
+                        available = a.availableValuesForCell(cell) & (1 << (b.getSolvedValue(twin.cell) - 1));
+                    }
+                    else {
+                        available = a.availableValuesForCell(cell) & b.availableValuesForCell(twin.cell);
+                        if (std::popcount(available) > 1) {
+                            continue;
+                        }
+                    }
+
+                    if (available == 0) {
+                        result.invalid = true;
+                        return result;
+                    }
+
+                    const uint8_t bitIndex = static_cast<uint8_t>(std::countr_zero(available));
+                    if (!solvedA) {
+                        a.setSolved(cell, bitIndex);
+                        dirty[grid] = true;
+                    }
+                    if (!solvedB) {
+                        b.setSolved(twin.cell, bitIndex);
+                        dirty[twin.grid] = true;
+                    }
+                    changed = true;
+                }
+            }
+
+            if (!changed) {
+                break;
+            }
+        }
+
+        result.solved = isFullySolved();
+        if (result.solved) {
+            return result;
+        }
+
+        for (size_t grid = 0; grid < GridCount; ++grid) {
+            uint8_t cell = 0;
+            while (true) {
+                cell = grids[grid].solvedIndices.nextUnsolvedOnOrAfter(cell);
+                if (cell >= 81) {
+                    break;
+                }
+
+                const typename Layout::Twin twin = layout->twins[grid][cell];
+                if (twin.grid == Layout::NO_TWIN || twin.grid > grid) {
+                    const uint8_t bitCount = static_cast<uint8_t>(std::popcount(availableValues(grid, cell)));
+                    if (bitCount < result.bitCount) {
+                        result.bestGrid = static_cast<uint8_t>(grid);
+                        result.bestCell = cell;
+                        result.bitCount = bitCount;
+                    }
+                }
+                ++cell;
+            }
+        }
+
+        return result;
+    }
+};
+
+/**
+ * depth first: a multi grid board is GridCount Boards, too big to queue up breadth first the way solve() does.
+ * stats are added to as for solveInto(const Board&, ...); `stack` is scratch space, reused across calls.
+ */
+template<size_t GridCount>
+SolveStatus solveInto(const MultiGrid<GridCount>& board, MultiGrid<GridCount>& solved, std::vector<MultiGrid<GridCount>>& stack,
+                      const MultiGridOptions& options, SolveStats& stats) {
+    const SolveOptions& limits = options.limits;
+    const bool hasDeadline = limits.deadline != SolveOptions::clock::time_point::max();
+    const bool stoppable = limits.stopToken.stop_possible();
+    const uint64_t startNodes = stats.nodes;
+    uint64_t nextCheck = stats.nodes;
+
+    stack.clear();
+    stack.push_back(board);
+    stack.back().fullComputeTakenVals();
+
+    while (!stack.empty()) {
+        if (stack.size() > stats.maxQueue) stats.maxQueue = stack.size();
+
+        if (stats.nodes - startNodes >= limits.nodeBudget) {
+            return SolveStatus::timedOut;
+        }
+
+        if (stats.nodes >= nextCheck) {
+            nextCheck = stats.nodes + SolveOptions::CHECK_INTERVAL;
+            if (stoppable && limits.stopToken.stop_requested()) {
+                return SolveStatus::cancelled;
+            }
+            if (hasDeadline && SolveOptions::clock::now() >= limits.deadline) {
+                return SolveStatus::timedOut;
+            }
+        }
+
+        ++stats.nodes;
+
+        MultiGrid<GridCount>& workingBoard = stack.back();
+        const typename MultiGrid<GridCount>::PropagateResult result = workingBoard.propagate(options.workers);
+
+        if (result.solved) {
+            solved = workingBoard;
+            return SolveStatus::solved;
+        }
+        else if (result.invalid) {
+            stack.pop_back();
+        }
+        else {
+            // pushed highest value first so the lowest is tried first, as the breadth first search does
+            const uint16_t candidates = workingBoard.availableValues(result.bestGrid, result.bestCell);
+            const MultiGrid<GridCount> parent = workingBoard;
+            stack.pop_back();
+            for (uint16_t remaining = candidates; remaining != 0; remaining &= ~(0x8000 >> std::countl_zero(remaining))) {
+                stack.push_back(parent);
+                stack.back().setSolved(result.bestGrid, result.bestCell, static_cast<uint8_t>(15 - std::countl_zero(remaining)));
+            }
+        }
+    }
+
+    return SolveStatus::unsolvable;
+}
+
+template<size_t GridCount>
+std::optional<MultiGrid<GridCount>> solve(const MultiGrid<GridCount>& board, const MultiGridOptions& options = {}) {
+    std::vector<MultiGrid<GridCount>> stack;
+    MultiGrid<GridCount> solved = board;
+    SolveStats stats;
+    if (solveInto(board, solved, stack, options, stats) == SolveStatus::solved) {
+        return {solved};
+    }
+    return std::nullopt;
+}
+
+using SamuraiBoard = MultiGrid<5>;
+
+/**
+ * samurai text format: 21 lines of 21 columns, the canvas of SAMURAI_LAYOUT. inside a grid, '1'-'9' is a
+ * clue and '0' or '.' an unknown; outside every grid (the gaps between the outer grids) must be ' ',
+ * and lines may stop short of 21 columns where the rest would be spaces.
+ * false on anything else, or clues clashing in some unit, possibly across an overlap.
+ */
+bool parseSamurai(const std::vector<std::string>& rows, SamuraiBoard& board);
+
+/**
+ * loads a file of samurai puzzles, each 21 lines as above; blank lines between puzzles and lines starting
+ * with '#' are skipped. a malformed puzzle is reported and skipped.
+ */
+std::vector<SamuraiBoard> loadSamuraiBoards(const char* fname);
+
+// the same 21 lines; unsolved cells are written as '.', trailing spaces are left off
+void writeSamurai(const SamuraiBoard& board, std::ostream& out);
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+// hardware counters read through perf_event_open (linux only)
+enum class PerfCounter : uint8_t { cycles, instructions, branchMisses, l1dMisses, llcMisses, count };
+
+inline constexpr size_t PERF_COUNTER_COUNT = static_cast<size_t>(PerfCounter::count);
+
+const char* perfCounterName(PerfCounter counter);
+
+struct CounterSample {
+    uint64_t values[PERF_COUNTER_COUNT] = {};
+};
+
+/**
+ * one perf event group for the calling thread, counting user space only.
+ * events the kernel or the cpu refuse (no PMU in a VM, perf_event_paranoid, not linux...) are left out;
+ * `has` says which made it, and `unavailableReason` why the group couldn't be opened at all.
+ * the events only count the thread that constructed the group (`owner`); reads from any other thread
+ * would charge it work it didn't see.
+ */
+class PerfCounterGroup {
+private:
+    int fds_[PERF_COUNTER_COUNT];
+    PerfCounter order_[PERF_COUNTER_COUNT]; // group read returns values in the order events were added
+    uint8_t opened_ = 0;
+    std::string unavailableReason_;
+    std::thread::id owner_ = std::this_thread::get_id();
+
+public:
+    PerfCounterGroup();
+    ~PerfCounterGroup();
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    bool available() const {
+        return opened_ > 0;
+    }
+
+    bool has(PerfCounter counter) const;
+
+    const std::string& unavailableReason() const {
+        return unavailableReason_;
+    }
+
+    std::thread::id owner() const {
+        return owner_;
+    }
+
+    // one read(2) of the whole group; scaled up if the kernel had to multiplex it.
+    // all zeros when unavailable
+    CounterSample read() const;
+};
+
+// the bits of the solver that get their own line in a profile
+enum class ProfiledKernel : uint8_t { solveLoop, fullComputeTakenVals, simpleSolve, branch, seededBranch, count };
+
+inline constexpr size_t PROFILED_KERNEL_COUNT = static_cast<size_t>(ProfiledKernel::count);
+
+const char* profiledKernelName(ProfiledKernel kernel);
+
+/**
+ * per kernel totals, filled in by solve() when SolveOptions::profile points at one.
+ * single threaded: only solve on the thread that constructed it (asserted in debug builds). nothing in it
+ * is synchronized, and its counters don't see other threads anyway.
+ * every kernel call costs a couple of read(2)s, so a profiled solve is much slower than a plain one
+ * and solveLoop (which contains the others) carries that overhead; compare kernels against each
+ * other and against the same kernel in another build, not against unprofiled wall time.
+ */
+struct KernelProfile {
+    struct Totals {
+        uint64_t calls = 0;
+        uint64_t nanos = 0;
+        CounterSample counters{};
+    };
+
+    PerfCounterGroup group;
+    Totals kernels[PROFILED_KERNEL_COUNT]{};
+
+    Totals& operator[](ProfiledKernel kernel) {
+        return kernels[static_cast<size_t>(kernel)];
+    }
+
+    const Totals& operator[](ProfiledKernel kernel) const {
+        return kernels[static_cast<size_t>(kernel)];
+    }
+
+    void reset() {
+        for (Totals& totals : kernels) {
+            totals = {};
+        }
+    }
+};
+
+// the counter flavour of withTime: run `f`, charge its cycles, misses etc. to `kernel`
+template<typename F>
+auto withCounters(KernelProfile& profile, ProfiledKernel kernel, F&& f) -> decltype(f()) {
+    assert(profile.group.owner() == std::this_thread::get_id() && "KernelProfile used off the thread that constructed it");
+
+    struct Charge {
+        KernelProfile& profile;
+        ProfiledKernel kernel;
+        CounterSample before;
+        std::chrono::steady_clock::time_point start;
+
+        ~Charge() {
+            const CounterSample after = profile.group.read();
+            const auto end = std::chrono::steady_clock::now();
+
+            KernelProfile::Totals& totals = profile[kernel];
+            totals.calls += 1;
+            totals.nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+                // scaled (multiplexed) values can come out slightly behind the previous read
+                if (after.values[i] > before.values[i]) {
+                    totals.counters.values[i] += after.values[i] - before.values[i];
+                }
+            }
+        }
+    } charge{ profile, kernel, profile.group.read(), std::chrono::steady_clock::now() };
+
+    return f();
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <cstdint>
+
+#include "susolv/board.h"
+
+struct PortfolioOptions {
+    // nodes the plain search gets before the race starts; puzzles solved within it never spawn a thread
+    uint64_t nodeThreshold = 20'000;
+
+    // searches raced against each other, seeded seed, seed + 1, ... (skipping 0, the unseeded search)
+    unsigned workers = 4;
+    uint64_t seed = 1;
+
+    // deadline / budget / stop token for the whole solve, plain phase and race included; the budget the plain
+    // phase leaves is split evenly between the racers.
+    // limits.seed is ignored. limits.engine, profile and trace only apply to the plain phase: the racers
+    // always run the cell-major search (the bitboard engine ignores seeds), and record nothing
+    SolveOptions limits{};
+};
+
+/**
+ * `solve`, but a puzzle that runs past `nodeThreshold` is restarted as `workers` concurrent searches
+ * with different tie-breaking seeds. the first search to finish (solved or unsolvable) wins and the
+ * others are cancelled. stats.nodes is the total over every search, stats.maxQueue the largest queue any had.
+ */
+SolveResult solvePortfolio(const Board& board, const PortfolioOptions& options);
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "susolv/board.h"
+
+/**
+ * multi threaded batches, ordered by predicted cost. every puzzle first gets a cheap probe (its clue count,
+ * fullComputeTakenVals and one simpleSolve, then what's left open), the probe predicts how many nodes the
+ * search will take, and workers pull puzzles longest-predicted-first. the few hard puzzles of a batch then
+ * start early instead of leaving one worker grinding at the end while the rest sit idle.
+ */
+
+struct PuzzleProbe {
+    uint8_t clues = 0;
+    uint8_t unsolved = 0;   // cells simpleSolve left open
+    float entropy = 0;      // log2 of the product of the open cells' candidate counts
+    bool settled = false;   // simpleSolve alone solved it, or found it invalid
+    float predictedNodes = 0;
+};
+
+PuzzleProbe probePuzzle(const Board& board);
+
+enum class BatchOrder {
+    input,                 // as given; no probes
+    longestPredictedFirst, // probed, then by predictedNodes, highest first
+};
+
+struct ScheduleOptions {
+    unsigned workers = 4; // 1 solves on the calling thread
+    BatchOrder order = BatchOrder::longestPredictedFirst;
+
+    // for every solve; with more than one worker, profile and trace are dropped, as they're single threaded
+    SolveOptions solve{};
+};
+
+struct ScheduledSolve {
+    SolveStatus status = SolveStatus::unsolvable;
+    uint64_t nodes = 0;
+    int64_t ns = 0;       // wall time of the solve
+    unsigned worker = 0;
+    PuzzleProbe probe{};  // all zero for BatchOrder::input
+};
+
+struct ScheduleReport {
+    std::vector<ScheduledSolve> puzzles; // in input order
+    std::vector<size_t> order;           // the order puzzles were handed out in
+    int64_t probeNs = 0;                 // all the probes, before any solving starts
+    int64_t makespanNs = 0;              // first solve started to last solve finished
+};
+
+/**
+ * solves `boards` into `solved` (resized to match; only entries with status solved mean anything) across
+ * options.workers threads. the whole schedule is fixed up front, and each thread takes the next puzzle
+ * of it (through one shared counter) whenever it finishes one.
+ */
+void solveScheduled(const std::vector<Board>& boards, std::vector<Board>& solved, const ScheduleOptions& options, ScheduleReport& report);
+
+struct PooledSolve {
+    uint64_t ticket = 0;
+    SolveStatus status = SolveStatus::unsolvable;
+    uint64_t nodes = 0;
+    Board solved;         // only meaningful if status == solved
+};
+
+/**
+ * solveScheduled for puzzles that arrive over time: a fixed set of options.workers threads, each taking
+ * whichever submitted puzzle is first in options.order (for longestPredictedFirst, the costliest probe
+ * among those queued; otherwise the oldest). results come back in completion order, under the ticket
+ * they were submitted with. a caller streaming a file keeps a window of puzzles submitted ahead of what
+ * it has written, so the threads never all wait on one straggler the way fixed chunks would.
+ * submit and collect are for one thread (the owner); profile and trace in options.solve are dropped.
+ */
+class SchedulePool {
+public:
+    explicit SchedulePool(const ScheduleOptions& options);
+    // cancels whatever is still being solved, and joins the threads
+    ~SchedulePool();
+
+    SchedulePool(const SchedulePool&) = delete;
+    SchedulePool& operator=(const SchedulePool&) = delete;
+
+    void submit(uint64_t ticket, const Board& board);
+
+    // waits until at least one submitted puzzle is done, unless none are outstanding, and appends every
+    // finished one to `done`
+    void collect(std::vector<PooledSolve>& done);
+
+    size_t outstanding() const { return outstanding_; }
+
+private:
+    struct Pending {
+        float priority;
+        uint64_t ticket;
+        Board board;
+
+        // highest priority first, then oldest ticket
+        bool operator<(const Pending& other) const {
+            return priority != other.priority ? priority < other.priority : ticket > other.ticket;
+        }
+    };
+
+    void work(std::stop_token stop);
+
+    BatchOrder order_;
+    SolveOptions solve_;
+    std::stop_source cancel_;          // the solves' stop token: the caller's, or the destructor
+    std::stop_callback<std::function<void()>> forwardStop_;
+    size_t outstanding_ = 0;           // submitted and not yet collected; only the owner touches it
+
+    std::mutex mutex_;
+    std::condition_variable_any queued_;
+    std::condition_variable finished_;
+    std::priority_queue<Pending> pending_;
+    std::vector<PooledSolve> done_;
+
+    // last, so the threads are joined before anything they use goes
+    std::vector<std::jthread> threads_;
+};
+
+/**
+ * makespan of greedy list scheduling: jobs handed out in `order`, each to whichever of `workers` frees up
+ * first. for replaying measured per puzzle costs under different orders / worker counts.
+ */
+double listScheduleMakespan(const std::vector<double>& costs, const std::vector<size_t>& order, unsigned workers);
+
+#endif
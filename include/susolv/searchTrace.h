@@ -0,0 +1,110 @@
+#ifndef SEARCH_TRACE_H
+#define SEARCH_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/**
+ * a record of what the cellMajor search did, for working out offline why a puzzle is slow.
+ * recording only exists in builds configured with -DSUSOLV_TRACE=ON; otherwise the search has no trace
+ * code in it at all and susolv_trace isn't built. SolveOptions::trace, SearchTrace and trace files are
+ * still there (so code using them builds either way), the pointer is just never looked at.
+ */
+
+#ifndef SUSOLV_TRACE
+#define SUSOLV_TRACE 0
+#endif
+
+inline constexpr bool TRACE_ENABLED = SUSOLV_TRACE;
+
+enum class TraceEventKind : uint8_t {
+    start = 0,     // a solve began; arg = clue count
+    propagate = 1, // a board came off the queue and went through simpleSolve; arg = cells it solved
+    branch = 2,    // a child was queued: `cell` set to `arg` (1-9), one event per candidate
+    invalid = 3,   // the board was a contradiction and was dropped
+    solved = 4,    // the board was solved; the search ends here
+    stopped = 5,   // the search ran out of budget or time, or was cancelled
+};
+
+// 8 bytes, written to trace files as is (host byte order)
+struct TraceEvent {
+    uint32_t node = 0;  // nodes taken off the queue before this one, in this solve; saturates at UINT32_MAX
+    TraceEventKind kind = TraceEventKind::start;
+    uint8_t depth = 0;  // branch decisions above the node, saturating at 255
+    uint8_t cell = 0;
+    uint8_t arg = 0;
+};
+
+static_assert(sizeof(TraceEvent) == 8);
+
+/**
+ * preallocated ring of events. one trace can span many solves, each starting with a `start` event.
+ * in memory, once full the oldest events are overwritten (and counted in dropped()).
+ * streamed to a file, the ring is only a buffer: it's written out every time it fills, so nothing is
+ * dropped however long the search runs. single threaded, like the search feeding it.
+ */
+class SearchTrace {
+public:
+    // in memory. capacity is rounded up to a power of two
+    explicit SearchTrace(size_t capacity = 1 << 20);
+
+    // streamed to `fname`, replacing it; ok() says whether it could be opened
+    explicit SearchTrace(const char* fname, size_t capacity = 1 << 16);
+
+    // flushes and closes a streamed trace
+    ~SearchTrace();
+    SearchTrace(const SearchTrace&) = delete;
+    SearchTrace& operator=(const SearchTrace&) = delete;
+
+    void record(const TraceEvent& event) {
+        ring_[recorded_ & mask_] = event;
+        ++recorded_;
+        if (sink_ != nullptr && recorded_ - written_ == ring_.size()) {
+            spill();
+        }
+    }
+
+    // in memory traces only; a streamed trace can't take back what it wrote
+    void clear() { recorded_ = written_ = 0; }
+
+    size_t capacity() const { return ring_.size(); }
+    uint64_t recorded() const { return recorded_; }
+    uint64_t dropped() const { return sink_ == nullptr && recorded_ > ring_.size() ? recorded_ - ring_.size() : 0; }
+
+    bool streamed() const { return sink_ != nullptr; }
+
+    // false once a streamed trace failed to open or to write
+    bool ok() const { return ok_; }
+
+    // streamed: writes out what's buffered and updates the file's header. ok()
+    bool flush();
+
+    // what's still in the ring, oldest first; for a streamed trace, what hasn't been written out yet
+    std::vector<TraceEvent> events() const;
+
+    // an in memory trace: header, then events() as is. false if the file can't be written
+    bool writeFile(const char* fname) const;
+
+private:
+    std::vector<TraceEvent> ring_;
+    size_t mask_;
+    uint64_t recorded_ = 0;
+    uint64_t written_ = 0;   // streamed: events already in the file
+    FILE* sink_ = nullptr;
+    bool ok_ = true;
+
+    void spill();
+};
+
+struct TraceFile {
+    uint64_t recorded = 0;
+    uint64_t dropped = 0;
+    std::vector<TraceEvent> events;
+};
+
+// false if the file can't be read or isn't a trace written by this version
+bool readTraceFile(const char* fname, TraceFile& trace);
+
+#endif
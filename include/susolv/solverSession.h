@@ -0,0 +1,71 @@
+#ifndef SOLVER_SESSION_H
+#define SOLVER_SESSION_H
+
+#include <cstdint>
+#include <deque>
+
+#include "susolv/board.h"
+
+enum class EditStatus : uint8_t {
+    solved,
+    unsolvable,
+    contradiction, // two equal clues share a unit, or some empty cell next to the edit has no candidates left
+    timedOut,
+    cancelled,
+    outOfRange,    // index not 0-80 or value not 1-9; the clues are left as they were
+};
+
+struct EditResult {
+    EditStatus status = EditStatus::unsolvable;
+    bool reused = false;  // the previous solution still held, no search was run
+    SolveStats stats{};   // of the search run for this edit, if any
+};
+
+/**
+ * a puzzle being edited one clue at a time, for interactive use.
+ * the clue board's takenValues and duplicate counts are kept per unit and only the row/col/quad of an
+ * edited cell are recomputed, which is enough to report a contradiction without searching.
+ * the last solution is reused as is when it still agrees with every clue (a clue was removed, or placed
+ * with the value the solution already had). otherwise the search starts from the clues plus the old
+ * solution outside the edited cell's units, and only if that fails from the bare clues.
+ */
+class SolverSession {
+private:
+    Board clues_;
+    Board solution_;
+    bool hasSolution_ = false;    // solution_ is a complete valid grid, though maybe not for the current clues
+    uint8_t duplicates_[27] = {}; // per unit (rows, cols, quads): clues beyond the first with the same value
+    uint16_t duplicateTotal_ = 0;
+    SolveOptions options_;
+    std::deque<Board> boards_;
+    EditResult last_;
+
+    void recomputeUnits(uint8_t cellIndex);
+    bool peersHaveCandidates(uint8_t cellIndex) const;
+    bool solutionFitsClues() const;
+    EditResult resolve(uint8_t editedIndex);
+
+public:
+    // `options` apply to every search the session runs
+    explicit SolverSession(const Board& clues, const SolveOptions& options = {});
+
+    // value is 1-9; replaces any clue already at index. out of range edits change nothing (not even
+    // lastResult) and return outOfRange
+    EditResult placeClue(uint8_t index, uint8_t value);
+    EditResult removeClue(uint8_t index);
+
+    const Board& clues() const {
+        return clues_;
+    }
+
+    // the solution for the current clues, or nullptr if the last edit didn't end with one
+    const Board* solution() const {
+        return last_.status == EditStatus::solved ? &solution_ : nullptr;
+    }
+
+    const EditResult& lastResult() const {
+        return last_;
+    }
+};
+
+#endif
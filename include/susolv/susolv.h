@@ -0,0 +1,57 @@
+#ifndef SUSOLV_H
+#define SUSOLV_H
+
+/**
+ * C ABI for FFI callers; everything here is a thin wrapper over susolv/batch.h and susolv/verify.h.
+ * buffers are packed 81 byte boards, see batch.h for the format.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(SUSOLV_SHARED)
+    #ifdef SUSOLV_BUILDING
+        #define SUSOLV_API __declspec(dllexport)
+    #else
+        #define SUSOLV_API __declspec(dllimport)
+    #endif
+#elif defined(__GNUC__) && defined(SUSOLV_SHARED)
+    #define SUSOLV_API __attribute__((visibility("default")))
+#else
+    #define SUSOLV_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SUSOLV_BOARD_CELLS 81
+
+/* values written to the `statuses` array, one byte per puzzle */
+#define SUSOLV_SOLVED        0
+#define SUSOLV_UNSOLVABLE    1
+#define SUSOLV_INVALID_INPUT 2
+
+/* returns the number of puzzles solved; `statuses` may be NULL */
+SUSOLV_API size_t susolv_solve_batch(const char* puzzles, char* solutions, uint8_t* statuses, size_t count);
+
+/* returns one of the SUSOLV_* status values */
+SUSOLV_API int susolv_solve(const char* puzzle, char* solution);
+
+/* values written to the `statuses` array by susolv_verify_batch, one byte per grid */
+#define SUSOLV_VERIFY_VALID          0
+#define SUSOLV_VERIFY_MALFORMED      1
+#define SUSOLV_VERIFY_CLUE_MISMATCH  2
+#define SUSOLV_VERIFY_UNIT_VIOLATION 3
+
+/* checks claimed solutions against their puzzles, no solving; returns the number of valid grids, `statuses` may be NULL */
+SUSOLV_API size_t susolv_verify_batch(const char* puzzles, const char* grids, uint8_t* statuses, size_t count);
+
+/* returns one of the SUSOLV_VERIFY_* status values */
+SUSOLV_API int susolv_verify(const char* puzzle, const char* grid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <chrono>
+#include <type_traits>
+
+using elapsed_t = decltype(std::chrono::high_resolution_clock::now() - std::chrono::high_resolution_clock::now());
+
+template<typename T>
+struct TimedResult {
+    T result;
+    elapsed_t elapsed;
+};
+
+template<>
+struct TimedResult<void> {
+    elapsed_t elapsed;
+};
+
+template<typename F>
+auto withTime(F&& f) -> TimedResult<decltype(f())> {
+    constexpr bool IS_VOID = std::is_same_v<decltype(f()), void>;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    auto result = [&f]() {
+        if constexpr (IS_VOID) {
+            return f(), 0;
+        }
+        else {
+            return f();
+        }
+    }();
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    if constexpr (IS_VOID) {
+        return { .elapsed = end - start };
+    }
+    else {
+        return {
+            .result = result,
+            .elapsed = end - start
+        };
+    }
+}
+
+inline auto toNanos(elapsed_t elapsed) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+#endif
@@ -0,0 +1,408 @@
+#ifndef VARIANT_BOARD_H
+#define VARIANT_BOARD_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+#include "susolv/board.h"
+#include "susolv/cellIndexLookup.h"
+
+/**
+ * Board with the set of constraint units as a template parameter, for the sudoku variants:
+ *
+ *   StandardLayout  rows, cols, quads                      (27 units)
+ *   DiagonalLayout  + both long diagonals (X-sudoku)       (29 units)
+ *   HyperLayout     + the 4 extra "windows" (windoku)      (31 units)
+ *   JigsawLayout    rows, cols, 9 irregular regions loaded at runtime
+ *
+ * each layout's UnitTable lists, per cell, the units it belongs to and its peers (every other cell
+ * sharing a unit with it). cells fall into classes by how many units they're in, and simpleSolve scans
+ * one class at a time with a loop over exactly that many units, so no slot is ever padded and the hot
+ * loop has no check on which units apply. setSolved / availableValuesForCell on an arbitrary cell find
+ * its class first, which costs nothing for a layout whose cells all have the same count (standard, jigsaw).
+ *
+ * `Board` stays the hand tuned standard-only path; VariantBoard<StandardLayout> is here to measure
+ * the generic code against it.
+ */
+
+template<size_t UnitCount, size_t MinUnitsPerCell, size_t MaxUnitsPerCell, size_t MaxPeersPerCell>
+struct UnitTable {
+    static constexpr size_t UNIT_COUNT = UnitCount;
+    static constexpr size_t MIN_UNITS_PER_CELL = MinUnitsPerCell;
+    static constexpr size_t MAX_UNITS_PER_CELL = MaxUnitsPerCell;
+    static constexpr size_t MAX_PEERS_PER_CELL = MaxPeersPerCell;
+
+    uint8_t unitCells[UnitCount][9]{};          // [unit][index...]
+    uint8_t cellUnits[81][MaxUnitsPerCell]{};   // [cell][unit...], the first unitCounts[cell] used
+    uint8_t unitCounts[81]{};                   // the cell's class
+    uint8_t peers[81][MaxPeersPerCell]{};       // [cell][peer...], ascending, the first peerCounts[cell] used
+    uint8_t peerCounts[81]{};
+    uint64_t classCells[MaxUnitsPerCell + 1][2]{}; // [class] cells 0-63, 64-80 as bits, like Board::SolvedCellTracker
+
+    // fills cellUnits / peers from unitCells; false if some cell ends up outside [Min, Max] units or
+    // with more than MaxPeersPerCell peers
+    constexpr bool link() {
+        for (int cell = 0; cell < 81; ++cell) {
+            unitCounts[cell] = 0;
+            peerCounts[cell] = 0;
+        }
+        for (size_t k = 0; k <= MaxUnitsPerCell; ++k) {
+            classCells[k][0] = 0;
+            classCells[k][1] = 0;
+        }
+
+        for (size_t unit = 0; unit < UnitCount; ++unit) {
+            for (int i = 0; i < 9; ++i) {
+                const uint8_t cell = unitCells[unit][i];
+                if (unitCounts[cell] == MaxUnitsPerCell) {
+                    return false;
+                }
+                cellUnits[cell][unitCounts[cell]++] = static_cast<uint8_t>(unit);
+            }
+        }
+
+        for (uint8_t cell = 0; cell < 81; ++cell) {
+            if (unitCounts[cell] < MinUnitsPerCell) {
+                return false;
+            }
+            classCells[unitCounts[cell]][cell / 64] |= uint64_t{ 1 } << (cell % 64);
+
+            bool isPeer[81]{};
+            for (uint8_t k = 0; k < unitCounts[cell]; ++k) {
+                for (int i = 0; i < 9; ++i) {
+                    isPeer[unitCells[cellUnits[cell][k]][i]] = true;
+                }
+            }
+            isPeer[cell] = false;
+
+            for (uint8_t peer = 0; peer < 81; ++peer) {
+                if (isPeer[peer]) {
+                    if (peerCounts[cell] == MaxPeersPerCell) {
+                        return false;
+                    }
+                    peers[cell][peerCounts[cell]++] = peer;
+                }
+            }
+        }
+
+        return true;
+    }
+};
+
+// rows in units [0,9), cols in [9,18), and quads in [18,27) if `quads`
+template<typename Table>
+constexpr Table rowsAndCols(bool quads) {
+    Table table;
+    for (int unit = 0; unit < 9; ++unit) {
+        for (int i = 0; i < 9; ++i) {
+            table.unitCells[unit][i] = cellIndexLookup.rowElementIndices[unit][i];
+            table.unitCells[9 + unit][i] = cellIndexLookup.colElementIndices[unit][i];
+            if (quads) {
+                table.unitCells[18 + unit][i] = cellIndexLookup.quadElementIndices[unit][i];
+            }
+        }
+    }
+    return table;
+}
+
+struct StandardLayout {
+    using Table = UnitTable<27, 3, 3, 20>;
+
+    static constexpr Table TABLE = []() {
+        Table table = rowsAndCols<Table>(true);
+        if (!table.link()) throw "bad standard layout";
+        return table;
+    }();
+
+    constexpr const Table& table() const {
+        return TABLE;
+    }
+};
+
+struct DiagonalLayout {
+    // the center cell is in its row, col, quad and both diagonals, which gives it 32 peers
+    using Table = UnitTable<29, 3, 5, 32>;
+
+    static constexpr Table TABLE = []() {
+        Table table = rowsAndCols<Table>(true);
+        for (int i = 0; i < 9; ++i) {
+            table.unitCells[27][i] = static_cast<uint8_t>(i * 10);    // top left to bottom right
+            table.unitCells[28][i] = static_cast<uint8_t>(8 + i * 8); // top right to bottom left
+        }
+        if (!table.link()) throw "bad diagonal layout";
+        return table;
+    }();
+
+    constexpr const Table& table() const {
+        return TABLE;
+    }
+};
+
+struct HyperLayout {
+    // the windows don't overlap each other, so a cell is in at most one
+    using Table = UnitTable<31, 3, 4, 24>;
+
+    static constexpr Table TABLE = []() {
+        Table table = rowsAndCols<Table>(true);
+        constexpr int corners[4][2] = { {1, 1}, {1, 5}, {5, 1}, {5, 5} };
+        for (int window = 0; window < 4; ++window) {
+            for (int i = 0; i < 9; ++i) {
+                const int y = corners[window][0] + i / 3;
+                const int x = corners[window][1] + i % 3;
+                table.unitCells[27 + window][i] = cellIndexLookup.rowElementIndices[y][x];
+            }
+        }
+        if (!table.link()) throw "bad hyper layout";
+        return table;
+    }();
+
+    constexpr const Table& table() const {
+        return TABLE;
+    }
+};
+
+class JigsawLayout {
+public:
+    // rows, cols and regions each cover the grid once; a region can add up to 8 peers of its own
+    using Table = UnitTable<27, 3, 3, 24>;
+
+private:
+    const Table* table_;
+
+public:
+    // `table` has to outlive every board using this layout
+    explicit JigsawLayout(const Table& table) : table_(&table) {}
+
+    const Table& table() const {
+        return *table_;
+    }
+};
+
+/**
+ * builds a jigsaw table from a region per cell (0-8, row-major).
+ * false unless every region has exactly 9 cells.
+ */
+bool makeJigsawTable(const uint8_t (&regionOf)[81], JigsawLayout::Table& table);
+
+/**
+ * loads a jigsaw region map: 81 region labels '1'-'9' (or 'a'-'i'), row-major,
+ * whitespace and '#' comment lines ignored
+ */
+bool loadJigsawTable(const char* fname, JigsawLayout::Table& table);
+
+template<typename Layout>
+class VariantBoard {
+public:
+    using Table = typename Layout::Table;
+
+    uint16_t cells[81];
+    Board::SolvedCellTracker solvedIndices;
+    uint16_t takenValues[Table::UNIT_COUNT]{};
+    [[no_unique_address]] Layout layout;
+
+    explicit VariantBoard(Layout _layout = Layout{}) : layout(_layout) {}
+
+    const Table& table() const {
+        return layout.table();
+    }
+
+    void setUnknown(uint8_t cellIndex) noexcept {
+        cells[cellIndex] = Board::ALL_VALUES_MASK;
+    }
+
+    // bitIndex 0 will set the lsb, bitIndex the next, etc
+    void setSolved(uint8_t cellIndex, uint8_t bitIndex) noexcept {
+        const uint16_t bit = 1 << bitIndex;
+
+        solvedIndices.setSolved(cellIndex);
+        forEachUnit<Table::MIN_UNITS_PER_CELL>(cellIndex, [this, bit](uint8_t unit) { takenValues[unit] |= bit; });
+        cells[cellIndex] = Board::SOLVED_FLAG | bit;
+    }
+
+    bool isSolved(uint8_t cellIndex) const noexcept {
+        return cells[cellIndex] & Board::SOLVED_FLAG;
+    }
+
+    // undefined behavior if cell is not solved
+    uint8_t getSolvedValue(uint8_t cellIndex) const noexcept {
+        return std::countr_zero(cells[cellIndex]) + 1;
+    }
+
+    uint16_t availableValuesForCell(uint8_t cellIndex) const noexcept {
+        uint16_t taken = 0;
+        forEachUnit<Table::MIN_UNITS_PER_CELL>(cellIndex, [this, &taken](uint8_t unit) { taken |= takenValues[unit]; });
+        return Board::ALL_VALUES_MASK & ~taken;
+    }
+
+    void fullComputeTakenVals() noexcept {
+        const Table& t = table();
+        for (size_t unit = 0; unit < Table::UNIT_COUNT; ++unit) {
+            uint16_t taken = 0;
+            for (int i = 0; i < 9; ++i) {
+                const uint8_t cell = t.unitCells[unit][i];
+                if (isSolved(cell)) {
+                    taken |= cells[cell] & Board::ALL_VALUES_MASK;
+                }
+            }
+            takenValues[unit] = taken;
+        }
+    }
+
+    // same contract as Board::simpleSolve, down to which cell is bestIndex on ties
+    Board::SimpleSolveResult simpleSolve() noexcept {
+        Board::SimpleSolveResult result;
+        bool didChange;
+        uint16_t best;
+
+        do {
+            didChange = false;
+            best = NO_BEST;
+            if (!simpleSolveClass<Table::MIN_UNITS_PER_CELL>(best, didChange)) {
+                result.invalid = true;
+                return result;
+            }
+        } while (didChange && !solvedIndices.boardIsFullySolved());
+
+        if (best != NO_BEST) {
+            result.bestIndex = static_cast<uint8_t>(best & 0x7F);
+            result.bitCount = static_cast<uint8_t>(best >> 7);
+        }
+        result.solved = solvedIndices.boardIsFullySolved();
+        return result;
+    }
+
+private:
+    // calls f on each unit of the cell: finds its class starting at Class, then an unrolled loop of exactly
+    // that many units. the last class needs no compare, so a one class layout has none at all
+    template<size_t Class, typename F>
+    void forEachUnit(uint8_t cellIndex, F&& f) const noexcept {
+        const Table& t = table();
+        if constexpr (Class < Table::MAX_UNITS_PER_CELL) {
+            if (t.unitCounts[cellIndex] != Class) {
+                forEachUnit<Class + 1>(cellIndex, f);
+                return;
+            }
+        }
+        for (size_t k = 0; k < Class; ++k) {
+            f(t.cellUnits[cellIndex][k]);
+        }
+    }
+
+    // the best cell so far as bitCount << 7 | index. classes aren't scanned in cell order, and a single
+    // compare on this keeps Board's tie break (lowest index) far cheaper than comparing count, then index
+    static constexpr uint16_t NO_BEST = 0xFFFF;
+
+    // one pass of simpleSolve over the unsolved cells in Class, then the classes above it.
+    // false if some cell has no candidates left
+    template<size_t Class>
+    bool simpleSolveClass(uint16_t& best, bool& didChange) noexcept {
+        const Table& t = table();
+        const uint64_t solvedBits[2] = { solvedIndices.b1, solvedIndices.b2 };
+        uint16_t classBest = best;
+        bool changed = false;
+
+        for (int word = 0; word < 2; ++word) {
+            for (uint64_t unsolved = t.classCells[Class][word] & ~solvedBits[word]; unsolved != 0; unsolved &= unsolved - 1) {
+                const uint8_t index = static_cast<uint8_t>(word * 64 + std::countr_zero(unsolved));
+
+                uint16_t taken = 0;
+                for (size_t k = 0; k < Class; ++k) {
+                    taken |= takenValues[t.cellUnits[index][k]];
+                }
+                const uint16_t available = Board::ALL_VALUES_MASK & ~taken;
+                const auto bitCount = std::popcount(available);
+
+                if (bitCount == 0) {
+                    return false;
+                }
+                else if (bitCount == 1) {
+                    solvedIndices.setSolved(index);
+                    for (size_t k = 0; k < Class; ++k) {
+                        takenValues[t.cellUnits[index][k]] |= available;
+                    }
+                    cells[index] = Board::SOLVED_FLAG | available;
+                    changed = true;
+                }
+                else {
+                    classBest = std::min(classBest, static_cast<uint16_t>(bitCount << 7 | index));
+                }
+            }
+        }
+
+        best = classBest;
+        didChange |= changed;
+        if constexpr (Class < Table::MAX_UNITS_PER_CELL) {
+            return simpleSolveClass<Class + 1>(best, didChange);
+        }
+        return true;
+    }
+};
+
+// packed 81 byte puzzle, as parseBoard in susolv/batch.h; false on bad bytes or clues clashing in some unit
+template<typename Layout>
+bool parseBoard(const char* cells, VariantBoard<Layout>& board) {
+    for (uint8_t index = 0; index < 81; ++index) {
+        board.setUnknown(index);
+    }
+    board.fullComputeTakenVals();
+
+    for (uint8_t index = 0; index < 81; ++index) {
+        const char c = cells[index];
+        if (c == '0' || c == '.') {
+            continue;
+        }
+
+        if (c < '1' || c > '9') {
+            return false;
+        }
+
+        const uint8_t bitIndex = static_cast<uint8_t>(c - '1');
+        if (!(board.availableValuesForCell(index) & (1 << bitIndex))) {
+            return false;
+        }
+        board.setSolved(index, bitIndex);
+    }
+
+    return true;
+}
+
+// same breadth first search as solve(const Board&)
+template<typename Layout>
+bool solveInto(const VariantBoard<Layout>& board, VariantBoard<Layout>& solved, std::deque<VariantBoard<Layout>>& boards) {
+    boards.clear();
+    boards.push_back(board);
+    boards.front().fullComputeTakenVals();
+
+    while (boards.size() > 0) {
+        VariantBoard<Layout>& workingBoard = boards.front();
+        Board::SimpleSolveResult result = workingBoard.simpleSolve();
+
+        if (result.solved) {
+            solved = workingBoard;
+            return true;
+        }
+        else if (!result.invalid) {
+            for (uint16_t candidates = workingBoard.availableValuesForCell(result.bestIndex); candidates != 0; candidates &= candidates - 1) {
+                boards.emplace_back(workingBoard).setSolved(result.bestIndex, static_cast<uint8_t>(std::countr_zero(candidates)));
+            }
+        }
+        boards.pop_front();
+    }
+
+    return false;
+}
+
+template<typename Layout>
+std::optional<VariantBoard<Layout>> solve(const VariantBoard<Layout>& board) {
+    std::deque<VariantBoard<Layout>> boards;
+    VariantBoard<Layout> solved = board;
+    if (solveInto(board, solved, boards)) {
+        return {solved};
+    }
+    return std::nullopt;
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include <cstddef>
+#include <cstdint>
+
+class Board;
+
+/**
+ * checks claimed solutions against their puzzles without searching: every clue of the puzzle is kept,
+ * and every row, col and quad of cellIndexLookup holds 1-9 exactly once.
+ * puzzles and grids are packed 81 byte boards, see susolv/batch.h.
+ */
+
+enum class VerifyStatus : uint8_t {
+    valid = 0,
+    malformed = 1,     // a grid byte outside '1'-'9', or a puzzle byte outside [0-9.]
+    clueMismatch = 2,  // the grid changes one of the puzzle's clues
+    unitViolation = 3, // some row, col or quad is missing a value (so has another twice)
+};
+
+// vectorized (SSE2 / AVX2 where the target has them, otherwise the scalar version below)
+VerifyStatus verifySolution(const char* puzzle, const char* grid);
+
+// the same for boards, as packed by writeBoard; a cell `solved` hasn't solved is malformed
+VerifyStatus verifySolution(const Board& puzzle, const Board& solved);
+
+// plain loops, one cell at a time; the reference the vector version is tested against
+VerifyStatus verifySolutionScalar(const char* puzzle, const char* grid);
+
+/**
+ * verifies `count` packed grids against `count` packed puzzles (both count * 81 bytes).
+ * `statuses` is optional; if non-null it gets one entry per grid.
+ * returns the number of valid grids.
+ */
+size_t verifyBatch(const char* puzzles, const char* grids, VerifyStatus* statuses, size_t count);
+
+#endif
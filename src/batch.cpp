@@ -0,0 +1,119 @@
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "susolv/batch.h"
+
+bool parseBoard(const char* cells, Board& board) {
+    uint16_t row[9] = {};
+    uint16_t col[9] = {};
+    uint16_t quad[9] = {};
+
+    for (uint8_t index = 0; index < BOARD_CELLS; ++index) {
+        const char c = cells[index];
+        if (c == '0' || c == '.') {
+            board.setUnknown(index);
+            continue;
+        }
+
+        if (c < '1' || c > '9') {
+            return false;
+        }
+
+        const uint16_t bit = 1 << (c - '1');
+        uint16_t& r = row[cellIndexLookup.indexToRow[index]];
+        uint16_t& k = col[cellIndexLookup.indexToCol[index]];
+        uint16_t& q = quad[cellIndexLookup.indexToQuad[index]];
+
+        if ((r | k | q) & bit) {
+            return false;
+        }
+
+        r |= bit;
+        k |= bit;
+        q |= bit;
+
+        board.setSolved(index, static_cast<uint8_t>(c - '1'));
+    }
+
+    return true;
+}
+
+std::vector<Board> loadPackedBoards(const char* fname) {
+    std::ifstream f(fname);
+
+    if (!f) {
+        std::cout << "Can't open " << fname << std::endl;
+        std::terminate();
+    }
+
+    std::vector<Board> result;
+    std::string line;
+    size_t lineNumber = 0;
+
+    while (std::getline(f, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        Board board;
+        if (line.size() != BOARD_CELLS || !parseBoard(line.data(), board)) {
+            std::cout << fname << ":" << lineNumber << ": not a puzzle, skipping" << std::endl;
+            continue;
+        }
+        result.push_back(board);
+    }
+
+    return result;
+}
+
+void writeBoard(const Board& board, char* cells) {
+    for (uint8_t index = 0; index < BOARD_CELLS; ++index) {
+        cells[index] = board.isSolved(index) ? static_cast<char>('0' + board.getSolvedValue(index)) : '0';
+    }
+}
+
+size_t solveBatch(const char* puzzles, char* solutions, BatchStatus* statuses, size_t count) {
+    // one work queue for the whole batch, so its blocks are reused from puzzle to puzzle
+    std::deque<Board> boards;
+    Board solved;
+    size_t solvedCount = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const char* puzzle = puzzles + i * BOARD_CELLS;
+        char* solution = solutions + i * BOARD_CELLS;
+
+        Board board;
+        BatchStatus status;
+
+        if (!parseBoard(puzzle, board)) {
+            status = BatchStatus::invalidInput;
+        }
+        else if (solveInto(board, solved, boards)) {
+            status = BatchStatus::solved;
+        }
+        else {
+            status = BatchStatus::unsolvable;
+        }
+
+        if (status == BatchStatus::solved) {
+            writeBoard(solved, solution);
+            ++solvedCount;
+        }
+        else {
+            std::memset(solution, '0', BOARD_CELLS);
+        }
+
+        if (statuses) {
+            statuses[i] = status;
+        }
+    }
+
+    return solvedCount;
+}
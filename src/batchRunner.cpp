@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "susolv/batch.h"
+#include "susolv/batchRunner.h"
+#include "susolv/schedule.h"
+
+namespace {
+
+constexpr const char* CHECKPOINT_MAGIC = "susolv-checkpoint 2";
+
+// puzzles read ahead of the output per worker: enough that the longest-first order has something to
+// reorder and the workers rarely run dry behind a straggler, without holding much of the file in memory
+constexpr size_t WINDOW_PER_WORKER = 64;
+
+void syncFile(FILE* f) {
+#ifdef _WIN32
+    _commit(_fileno(f));
+#else
+    fsync(fileno(f));
+#endif
+}
+
+} // namespace
+
+bool readCheckpoint(const std::string& path, BatchRunStats& stats) {
+    FILE* f = fopen(path.c_str(), "r");
+    if (f == NULL) {
+        return false;
+    }
+
+    char magic[32] = {};
+    const bool ok = fgets(magic, sizeof(magic), f) != NULL
+        && std::strncmp(magic, CHECKPOINT_MAGIC, std::strlen(CHECKPOINT_MAGIC)) == 0
+        && fscanf(f,
+            "input_offset %" SCNu64 "\n"
+            "output_offset %" SCNu64 "\n"
+            "completed %" SCNu64 "\n"
+            "solved %" SCNu64 "\n"
+            "unsolvable %" SCNu64 "\n"
+            "invalid %" SCNu64 "\n"
+            "timed_out %" SCNu64 "\n"
+            "nodes %" SCNu64 "\n"
+            "input_size %" SCNu64 "\n",
+            &stats.inputOffset, &stats.outputOffset, &stats.completed, &stats.solved,
+            &stats.unsolvable, &stats.invalid, &stats.timedOut, &stats.nodes, &stats.inputSize) == 9;
+
+    // the path goes last and takes the rest of its line, spaces and all
+    char line[4096];
+    constexpr const char* PATH_KEY = "input_path ";
+    const bool pathOk = ok && fgets(line, sizeof(line), f) != NULL && std::strncmp(line, PATH_KEY, std::strlen(PATH_KEY)) == 0;
+    if (pathOk) {
+        stats.inputPath = line + std::strlen(PATH_KEY);
+        if (!stats.inputPath.empty() && stats.inputPath.back() == '\n') {
+            stats.inputPath.pop_back();
+        }
+    }
+
+    fclose(f);
+    return pathOk;
+}
+
+bool writeCheckpoint(const std::string& path, const BatchRunStats& stats, bool sync) {
+    const std::string tmp = path + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "w");
+    if (f == NULL) {
+        return false;
+    }
+
+    fprintf(f,
+        "%s\n"
+        "input_offset %" PRIu64 "\n"
+        "output_offset %" PRIu64 "\n"
+        "completed %" PRIu64 "\n"
+        "solved %" PRIu64 "\n"
+        "unsolvable %" PRIu64 "\n"
+        "invalid %" PRIu64 "\n"
+        "timed_out %" PRIu64 "\n"
+        "nodes %" PRIu64 "\n"
+        "input_size %" PRIu64 "\n"
+        "input_path %s\n",
+        CHECKPOINT_MAGIC, stats.inputOffset, stats.outputOffset, stats.completed, stats.solved,
+        stats.unsolvable, stats.invalid, stats.timedOut, stats.nodes, stats.inputSize, stats.inputPath.c_str());
+
+    const bool written = fflush(f) == 0 && !ferror(f);
+    if (sync) {
+        syncFile(f);
+    }
+    if (fclose(f) != 0 || !written) {
+        std::error_code error;
+        std::filesystem::remove(tmp, error);
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tmp, path, error);
+    return !error;
+}
+
+bool runBatch(const BatchRunOptions& options, BatchRunStats& stats) {
+    const bool checkpointing = !options.checkpointPath.empty();
+    stats = {};
+
+    // what the checkpoint pins the run to; resuming against any other input would skip into the wrong puzzles
+    std::error_code inputError;
+    const std::string inputPath = std::filesystem::weakly_canonical(options.inputPath, inputError).string();
+    const uint64_t inputSize = inputError ? 0 : std::filesystem::file_size(options.inputPath, inputError);
+    if (inputError) {
+        std::cerr << "Can't open " << options.inputPath << std::endl;
+        return false;
+    }
+
+    if (checkpointing && std::filesystem::exists(options.checkpointPath)) {
+        if (!readCheckpoint(options.checkpointPath, stats)) {
+            std::cerr << "Can't read checkpoint " << options.checkpointPath << std::endl;
+            return false;
+        }
+        if (stats.inputPath != inputPath || stats.inputSize != inputSize) {
+            std::cerr << "Checkpoint " << options.checkpointPath << " is for " << stats.inputPath << " (" << stats.inputSize
+                << " bytes), not " << inputPath << " (" << inputSize << " bytes)" << std::endl;
+            return false;
+        }
+        stats.resumed = true;
+
+        // drop whatever made it out after the last checkpoint; it's redone below
+        std::error_code error;
+        std::filesystem::resize_file(options.outputPath, stats.outputOffset, error);
+        if (error) {
+            std::cerr << "Can't truncate " << options.outputPath << ": " << error.message() << std::endl;
+            return false;
+        }
+    }
+
+    std::ifstream input(options.inputPath, std::ios::binary);
+    if (!input) {
+        std::cerr << "Can't open " << options.inputPath << std::endl;
+        return false;
+    }
+    input.seekg(static_cast<std::streamoff>(stats.inputOffset));
+    stats.inputPath = inputPath;
+    stats.inputSize = inputSize;
+
+    FILE* output = fopen(options.outputPath.c_str(), stats.resumed ? "ab" : "wb");
+    if (output == NULL) {
+        std::cerr << "Can't open " << options.outputPath << std::endl;
+        return false;
+    }
+
+    // read but not yet written, in input order. with workers, puzzles are handed to the pool as they're
+    // read and come back in whatever order they finish; lines only go out (and checkpoints only cover
+    // them) once everything before them is done
+    struct Line {
+        bool valid = false;
+        bool done = false;
+        SolveStatus status = SolveStatus::unsolvable;
+        uint64_t nodes = 0;
+        uint64_t inputEnd = 0; // input offset just past the line, for the checkpoint written after it
+        Board solved;
+    };
+
+    const unsigned workers = std::max(1u, options.workers);
+    std::optional<SchedulePool> pool;
+    if (workers > 1) {
+        ScheduleOptions schedule;
+        schedule.workers = workers;
+        schedule.order = options.order;
+        schedule.solve = options.solve;
+        pool.emplace(schedule);
+    }
+    // on one thread each puzzle is solved as it's read, so there's nothing to read ahead for
+    const size_t windowLimit = pool ? WINDOW_PER_WORKER * workers : 1;
+
+    std::deque<Line> window;
+    uint64_t windowStart = 0; // ticket of window.front()
+    std::vector<PooledSolve> finished;
+    std::deque<Board> queue;
+
+    char line[BOARD_CELLS + 1];
+    line[BOARD_CELLS] = '\n';
+
+    std::string text;
+    uint64_t readOffset = stats.inputOffset;
+    uint64_t readThisRun = 0;
+    uint64_t doneThisRun = 0;
+    uint64_t sinceCheckpoint = 0;
+    bool more = true;
+
+    while (true) {
+        while (more && window.size() < windowLimit && readThisRun < options.stopAfter) {
+            if (!(more = static_cast<bool>(std::getline(input, text)))) {
+                break;
+            }
+            readOffset += text.size() + (input.eof() ? 0 : 1);
+
+            if (!text.empty() && text.back() == '\r') {
+                text.pop_back();
+            }
+            if (text.empty() || text[0] == '#') {
+                continue;
+            }
+
+            Line& entry = window.emplace_back();
+            entry.inputEnd = readOffset;
+            ++readThisRun;
+
+            Board board;
+            entry.valid = text.size() == BOARD_CELLS && parseBoard(text.data(), board);
+            if (!entry.valid) {
+                entry.done = true;
+            }
+            else if (pool) {
+                pool->submit(windowStart + window.size() - 1, board);
+            }
+            else {
+                SolveStats solveStats;
+                entry.status = solveInto(board, entry.solved, queue, options.solve, solveStats);
+                entry.nodes = solveStats.nodes;
+                entry.done = true;
+            }
+        }
+
+        while (!window.empty() && window.front().done) {
+            const Line& entry = window.front();
+            if (!entry.valid) {
+                std::memset(line, '0', BOARD_CELLS);
+                ++stats.invalid;
+            }
+            else {
+                switch (entry.status) {
+                case SolveStatus::solved:
+                    writeBoard(entry.solved, line);
+                    ++stats.solved;
+                    break;
+                case SolveStatus::unsolvable:
+                    std::memset(line, '0', BOARD_CELLS);
+                    ++stats.unsolvable;
+                    break;
+                default:
+                    std::memset(line, '0', BOARD_CELLS);
+                    ++stats.timedOut;
+                    break;
+                }
+                stats.nodes += entry.nodes;
+            }
+
+            fwrite(line, 1, sizeof(line), output);
+            stats.inputOffset = entry.inputEnd;
+            stats.outputOffset += sizeof(line);
+            ++stats.completed;
+            ++doneThisRun;
+            window.pop_front();
+            ++windowStart;
+
+            if (checkpointing && ++sinceCheckpoint == options.checkpointEvery) {
+                // output first, so a checkpoint never points past what's on disk
+                fflush(output);
+                if (options.sync) {
+                    syncFile(output);
+                }
+                if (!writeCheckpoint(options.checkpointPath, stats, options.sync)) {
+                    // carrying on would look resumable when it isn't
+                    std::cerr << "Can't write checkpoint " << options.checkpointPath << std::endl;
+                    fclose(output);
+                    return false;
+                }
+                sinceCheckpoint = 0;
+            }
+        }
+
+        if (window.empty()) {
+            if (!more || readThisRun == options.stopAfter) {
+                break;
+            }
+            continue; // room to read more
+        }
+
+        // the head is still being solved (only possible with a pool); wait for something to finish
+        finished.clear();
+        pool->collect(finished);
+        for (PooledSolve& result : finished) {
+            Line& entry = window[result.ticket - windowStart];
+            entry.status = result.status;
+            entry.nodes = result.nodes;
+            entry.solved = result.solved;
+            entry.done = true;
+        }
+    }
+
+    // trailing comments and blank lines count as read too
+    stats.inputOffset = readOffset;
+
+    fflush(output);
+    if (options.sync) {
+        syncFile(output);
+    }
+    fclose(output);
+
+    if (checkpointing && doneThisRun < options.stopAfter) {
+        // the whole input is done; a later run starts over rather than resuming into an empty tail
+        std::error_code error;
+        std::filesystem::remove(options.checkpointPath, error);
+    }
+
+    return true;
+}
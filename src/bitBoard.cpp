@@ -0,0 +1,316 @@
+#include <bit>
+#include <vector>
+
+#include "susolv/bitBoard.h"
+
+namespace {
+
+struct BandTables {
+    uint32_t rowMask[3];            // [row in band]
+    uint32_t boxMask[3];            // [box in band]
+    uint32_t colMask[9];            // [col], same in every band
+    uint32_t peerMask[81][3];       // [cell][band], the cell's row, col and box, itself included
+    uint8_t band[81];
+    uint8_t bit[81];
+
+    constexpr BandTables() : rowMask(), boxMask(), colMask(), peerMask(), band(), bit() {
+        for (int r = 0; r < 3; ++r) {
+            rowMask[r] = 0x1FFu << (9 * r);
+        }
+        for (int box = 0; box < 3; ++box) {
+            boxMask[box] = (0x7u << (3 * box)) | (0x7u << (9 + 3 * box)) | (0x7u << (18 + 3 * box));
+        }
+        for (int col = 0; col < 9; ++col) {
+            colMask[col] = (1u << col) | (1u << (9 + col)) | (1u << (18 + col));
+        }
+
+        for (int cell = 0; cell < 81; ++cell) {
+            const int row = cell / 9;
+            const int col = cell % 9;
+            band[cell] = static_cast<uint8_t>(row / 3);
+            bit[cell] = static_cast<uint8_t>(9 * (row % 3) + col);
+
+            for (int b = 0; b < 3; ++b) {
+                peerMask[cell][b] = colMask[col];
+            }
+            peerMask[cell][row / 3] |= rowMask[row % 3] | boxMask[col / 3];
+        }
+    }
+};
+
+inline constexpr BandTables bandTables{};
+
+uint8_t cellOf(int band, int bit) {
+    return static_cast<uint8_t>(27 * band + bit);
+}
+
+} // namespace
+
+bool BitBoard::load(const Board& board) {
+    uint32_t ruledOut[9][3] = {}; // [digit][band], peers of the clues with that digit
+    uint32_t occupied[3] = {};
+
+    for (int d = 0; d < 9; ++d) {
+        for (int b = 0; b < 3; ++b) {
+            placed[d][b] = 0;
+        }
+    }
+
+    for (uint8_t cell = 0; cell < 81; ++cell) {
+        if (!board.isSolved(cell)) {
+            continue;
+        }
+
+        const uint8_t d = board.getSolvedValue(cell) - 1;
+        const uint8_t band = bandTables.band[cell];
+        const uint32_t bit = 1u << bandTables.bit[cell];
+
+        if (ruledOut[d][band] & bit) {
+            return false;
+        }
+        for (int b = 0; b < 3; ++b) {
+            ruledOut[d][b] |= bandTables.peerMask[cell][b];
+        }
+        placed[d][band] |= bit;
+        occupied[band] |= bit;
+    }
+
+    for (int b = 0; b < 3; ++b) {
+        unsolved[b] = BAND_MASK & ~occupied[b];
+        for (int d = 0; d < 9; ++d) {
+            candidates[d][b] = unsolved[b] & ~ruledOut[d][b];
+        }
+    }
+
+    return true;
+}
+
+void BitBoard::store(Board& board) const {
+    for (uint16_t d = 0; d < 9; ++d) {
+        for (int b = 0; b < 3; ++b) {
+            for (uint32_t cells = placed[d][b]; cells != 0; cells &= cells - 1) {
+                board.cells[cellOf(b, std::countr_zero(cells))] = Board::SOLVED_FLAG | (1 << d);
+            }
+        }
+    }
+
+    // every cell and every unit is full
+    board.solvedIndices.b1 = 0xffff'ffff'ffff'ffff;
+    board.solvedIndices.b2 = 0x0001'ffff;
+    for (int unit = 0; unit < 9; ++unit) {
+        board.takenValues.row[unit] = Board::TAKEN_INIT | Board::ALL_VALUES_MASK;
+        board.takenValues.col[unit] = Board::TAKEN_INIT | Board::ALL_VALUES_MASK;
+        board.takenValues.quad[unit] = Board::TAKEN_INIT | Board::ALL_VALUES_MASK;
+    }
+}
+
+bool BitBoard::place(uint8_t cellIndex, uint8_t digit) {
+    const uint8_t band = bandTables.band[cellIndex];
+    const uint32_t bit = 1u << bandTables.bit[cellIndex];
+
+    if (!(candidates[digit][band] & bit)) {
+        return false;
+    }
+
+    for (int d = 0; d < 9; ++d) {
+        candidates[d][band] &= ~bit;
+    }
+    for (int b = 0; b < 3; ++b) {
+        candidates[digit][b] &= ~bandTables.peerMask[cellIndex][b];
+    }
+    placed[digit][band] |= bit;
+    unsolved[band] &= ~bit;
+
+    return true;
+}
+
+uint16_t BitBoard::candidatesForCell(uint8_t cellIndex) const {
+    const uint8_t band = bandTables.band[cellIndex];
+    const uint8_t bit = bandTables.bit[cellIndex];
+    uint16_t result = 0;
+    for (int d = 0; d < 9; ++d) {
+        result |= ((candidates[d][band] >> bit) & 1) << d;
+    }
+    return result;
+}
+
+BitBoard::PropagateResult BitBoard::propagate() {
+    PropagateResult result;
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+
+        // naked singles: bit-sliced "at least 1 / at least 2" candidate counts per cell, a band at a time
+        for (int b = 0; b < 3; ++b) {
+            uint32_t ones = 0, twos = 0;
+            for (int d = 0; d < 9; ++d) {
+                twos |= ones & candidates[d][b];
+                ones |= candidates[d][b];
+            }
+
+            if (unsolved[b] & ~ones) {
+                result.invalid = true;
+                return result;
+            }
+
+            for (uint32_t singles = ones & ~twos; singles != 0; singles &= singles - 1) {
+                const int bit = std::countr_zero(singles);
+                int d = 0;
+                while (d < 9 && !(candidates[d][b] & (1u << bit))) ++d;
+                // an earlier single this pass may have taken this cell's last candidate
+                if (d == 9) {
+                    result.invalid = true;
+                    return result;
+                }
+                place(cellOf(b, bit), static_cast<uint8_t>(d));
+                changed = true;
+            }
+        }
+
+        // naked singles are much cheaper, so only look for hidden ones once those run dry
+        if (changed) {
+            continue;
+        }
+
+        // hidden singles, and units with nowhere left for a digit
+        for (int d = 0; d < 9; ++d) {
+            // cols: slice counts over the 9 rows, folded into 9 bits
+            uint32_t ones = 0, twos = 0, done = 0;
+            for (int b = 0; b < 3; ++b) {
+                for (int r = 0; r < 3; ++r) {
+                    const uint32_t row = (candidates[d][b] >> (9 * r)) & 0x1FF;
+                    twos |= ones & row;
+                    ones |= row;
+                    done |= (placed[d][b] >> (9 * r)) & 0x1FF;
+                }
+            }
+            if (~(ones | done) & 0x1FF) {
+                result.invalid = true;
+                return result;
+            }
+            for (uint32_t cols = ones & ~twos; cols != 0; cols &= cols - 1) {
+                const int col = std::countr_zero(cols);
+                for (int b = 0; b < 3; ++b) {
+                    const uint32_t hit = candidates[d][b] & bandTables.colMask[col];
+                    if (hit) {
+                        place(cellOf(b, std::countr_zero(hit)), static_cast<uint8_t>(d));
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+
+            // rows and boxes: one masked popcount each
+            for (int b = 0; b < 3; ++b) {
+                for (int u = 0; u < 3; ++u) {
+                    for (uint32_t mask : { bandTables.rowMask[u], bandTables.boxMask[u] }) {
+                        if (placed[d][b] & mask) {
+                            continue;
+                        }
+                        const uint32_t hit = candidates[d][b] & mask;
+                        if (hit == 0) {
+                            result.invalid = true;
+                            return result;
+                        }
+                        if (std::has_single_bit(hit)) {
+                            place(cellOf(b, std::countr_zero(hit)), static_cast<uint8_t>(d));
+                            changed = true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if ((unsolved[0] | unsolved[1] | unsolved[2]) == 0) {
+        result.solved = true;
+        return result;
+    }
+
+    // branch cell: the first one with exactly two candidates, else the smallest count found by a scan
+    uint32_t ones[3], twos[3], threes[3];
+    for (int b = 0; b < 3; ++b) {
+        ones[b] = twos[b] = threes[b] = 0;
+        for (int d = 0; d < 9; ++d) {
+            threes[b] |= twos[b] & candidates[d][b];
+            twos[b] |= ones[b] & candidates[d][b];
+            ones[b] |= candidates[d][b];
+        }
+        const uint32_t pairs = twos[b] & ~threes[b] & unsolved[b];
+        if (pairs) {
+            result.bestIndex = cellOf(b, std::countr_zero(pairs));
+            return result;
+        }
+    }
+
+    int bestCount = 10;
+    for (int b = 0; b < 3; ++b) {
+        for (uint32_t cells = unsolved[b]; cells != 0; cells &= cells - 1) {
+            const uint8_t cell = cellOf(b, std::countr_zero(cells));
+            const int count = std::popcount(candidatesForCell(cell));
+            if (count < bestCount) {
+                bestCount = count;
+                result.bestIndex = cell;
+            }
+        }
+    }
+
+    return result;
+}
+
+SolveStatus solveBitboard(const Board& board, Board& solved, const SolveOptions& options, SolveStats& stats) {
+    std::vector<BitBoard> stack(1);
+    stack.reserve(32);
+
+    if (!stack.back().load(board)) {
+        return SolveStatus::unsolvable;
+    }
+
+    const bool hasDeadline = options.deadline != SolveOptions::clock::time_point::max();
+    const bool stoppable = options.stopToken.stop_possible();
+    const uint64_t startNodes = stats.nodes;
+    uint64_t nextCheck = stats.nodes;
+
+    while (!stack.empty()) {
+        if (stack.size() > stats.maxQueue) stats.maxQueue = stack.size();
+
+        if (stats.nodes - startNodes >= options.nodeBudget) {
+            return SolveStatus::timedOut;
+        }
+
+        if (stats.nodes >= nextCheck) {
+            nextCheck = stats.nodes + SolveOptions::CHECK_INTERVAL;
+            if (stoppable && options.stopToken.stop_requested()) {
+                return SolveStatus::cancelled;
+            }
+            if (hasDeadline && SolveOptions::clock::now() >= options.deadline) {
+                return SolveStatus::timedOut;
+            }
+        }
+
+        ++stats.nodes;
+
+        BitBoard working = stack.back();
+        stack.pop_back();
+
+        BitBoard::PropagateResult result = working.propagate();
+
+        if (result.solved) {
+            working.store(solved);
+            return SolveStatus::solved;
+        }
+        else if (!result.invalid) {
+            // pushed in reverse so the lowest digit is tried first
+            uint16_t digits = working.candidatesForCell(result.bestIndex);
+            while (digits != 0) {
+                const uint8_t d = static_cast<uint8_t>(15 - std::countl_zero(digits));
+                digits &= ~(1 << d);
+                stack.push_back(working);
+                stack.back().place(result.bestIndex, d);
+            }
+        }
+    }
+
+    return SolveStatus::unsolvable;
+}
@@ -3,7 +3,10 @@
 #include <iostream>
 #include <optional>
 
+#include "susolv/bitBoard.h"
 #include "susolv/board.h"
+#include "susolv/perfCounters.h"
+#include "susolv/searchTrace.h"
 
 #define CELL_GROUP_ITERATOR_STATIC_SENTINEL(which)                      \
     template<>                                                          \
@@ -90,32 +93,230 @@ Board loadBoard(const char* fname) {
     return board;
 }
 
-std::optional<Board> solve(const Board& board) {
-    std::deque<Board> boards{ board };
-    boards.front().fullComputeTakenVals();
+namespace {
+
+// splitmix64, only used to shuffle branch order for seeded searches
+struct SearchRng {
+    uint64_t state;
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9e37'79b9'7f4a'7c15);
+        z = (z ^ (z >> 30)) * 0xbf58'476d'1ce4'e5b9;
+        z = (z ^ (z >> 27)) * 0x94d0'49bb'1331'11eb;
+        return z ^ (z >> 31);
+    }
+
+    uint32_t below(uint32_t n) {
+        return static_cast<uint32_t>(next() % n);
+    }
+};
+
+// pick uniformly among the unsolved cells that have as few candidates as `result.bestIndex`
+uint8_t randomBestIndex(const Board& board, const Board::SimpleSolveResult& result, SearchRng& rng) {
+    uint8_t ties[81];
+    uint8_t tieCount = 0;
+
+    uint8_t index = 0;
+    while (true) {
+        index = board.solvedIndices.nextUnsolvedOnOrAfter(index);
+        if (index >= 81) {
+            break;
+        }
+        if (std::popcount(board.availableValuesForCell(index)) == result.bitCount) {
+            ties[tieCount++] = index;
+        }
+        ++index;
+    }
+
+    return ties[rng.below(tieCount)];
+}
+
+// `f()`, charged to `kernel` in options.profile for profiled searches
+template<bool Profiled, typename F>
+decltype(auto) profiled(const SolveOptions& options, ProfiledKernel kernel, F&& f) {
+    if constexpr (Profiled) {
+        return withCounters(*options.profile, kernel, std::forward<F>(f));
+    }
+    else {
+        return f();
+    }
+}
+
+template<bool Seeded, bool Profiled, bool Traced>
+SolveStatus search(const Board& board, Board& solved, std::deque<Board>& boards, const SolveOptions& options, SolveStats& stats) {
+    SearchRng rng{ options.seed };
+
+    boards.clear();
+    boards.push_back(board);
+    profiled<Profiled>(options, ProfiledKernel::fullComputeTakenVals, [&]() { boards.front().fullComputeTakenVals(); });
+
+    const bool hasDeadline = options.deadline != SolveOptions::clock::time_point::max();
+    const bool stoppable = options.stopToken.stop_possible();
+    const uint64_t startNodes = stats.nodes;
+    uint64_t nextCheck = stats.nodes;
+
+    // breadth first, so the depth only moves on once the last board of a level comes off the queue
+    [[maybe_unused]] uint32_t depth = 0;
+    [[maybe_unused]] size_t levelRemaining = 1;
+    [[maybe_unused]] size_t nextLevel = 0;
+    [[maybe_unused]] uint64_t node = 0;
+
+    [[maybe_unused]] auto trace = [&](TraceEventKind kind, uint8_t cell, uint8_t arg) {
+        options.trace->record({ static_cast<uint32_t>(std::min<uint64_t>(node, UINT32_MAX)), kind, static_cast<uint8_t>(std::min<uint32_t>(depth, 255)), cell, arg });
+    };
+    [[maybe_unused]] auto solvedCells = [](const Board& b) {
+        return static_cast<uint8_t>(std::popcount(b.solvedIndices.b1) + std::popcount(b.solvedIndices.b2));
+    };
+    [[maybe_unused]] auto nextNode = [&](size_t children) {
+        nextLevel += children;
+        if (--levelRemaining == 0) {
+            ++depth;
+            levelRemaining = nextLevel;
+            nextLevel = 0;
+        }
+    };
+
+    if constexpr (Traced) {
+        trace(TraceEventKind::start, 0, solvedCells(board));
+    }
 
-    size_t maxSize = 0;
     while (boards.size() > 0) {
-        if (boards.size() > maxSize) maxSize = boards.size();
+        if (boards.size() > stats.maxQueue) stats.maxQueue = boards.size();
+        if constexpr (Traced) {
+            node = stats.nodes - startNodes;
+        }
+
+        if (stats.nodes - startNodes >= options.nodeBudget) {
+            if constexpr (Traced) trace(TraceEventKind::stopped, 0, 0);
+            return SolveStatus::timedOut;
+        }
+
+        // the clock and the stop token are comparatively expensive, so only look every so often
+        if (stats.nodes >= nextCheck) {
+            nextCheck = stats.nodes + SolveOptions::CHECK_INTERVAL;
+            if (stoppable && options.stopToken.stop_requested()) {
+                if constexpr (Traced) trace(TraceEventKind::stopped, 0, 0);
+                return SolveStatus::cancelled;
+            }
+            if (hasDeadline && SolveOptions::clock::now() >= options.deadline) {
+                if constexpr (Traced) trace(TraceEventKind::stopped, 0, 0);
+                return SolveStatus::timedOut;
+            }
+        }
+
+        ++stats.nodes;
 
         Board& workingBoard = boards.front();
-        Board::SimpleSolveResult result = workingBoard.simpleSolve();
+        [[maybe_unused]] uint8_t solvedBefore = 0;
+        if constexpr (Traced) {
+            solvedBefore = solvedCells(workingBoard);
+        }
+
+        Board::SimpleSolveResult result = profiled<Profiled>(options, ProfiledKernel::simpleSolve, [&]() { return workingBoard.simpleSolve(); });
+
+        if constexpr (Traced) {
+            trace(TraceEventKind::propagate, 0, static_cast<uint8_t>(solvedCells(workingBoard) - solvedBefore));
+        }
 
         if (result.solved) {
-            // std::cout << "SOLVED" << std::endl;
-            // std::cout << "max boards..." << maxSize << std::endl;
-            return {workingBoard};
+            if constexpr (Traced) trace(TraceEventKind::solved, 0, 0);
+            solved = workingBoard;
+            return SolveStatus::solved;
         }
         else if (result.invalid) {
+            if constexpr (Traced) {
+                trace(TraceEventKind::invalid, 0, 0);
+                nextNode(0);
+            }
+            boards.pop_front();
+        }
+        else if constexpr (Seeded) {
+            const uint8_t cellIndex = randomBestIndex(workingBoard, result, rng);
+            uint16_t candidates = workingBoard.availableValuesForCell(cellIndex);
+
+            uint8_t values[9];
+            uint8_t valueCount = 0;
+            for (; candidates != 0; candidates &= candidates - 1) {
+                values[valueCount++] = static_cast<uint8_t>(std::countr_zero(candidates));
+            }
+            for (uint8_t i = valueCount; i > 1; --i) {
+                std::swap(values[i - 1], values[rng.below(i)]);
+            }
+
+            for (uint8_t i = 0; i < valueCount; ++i) {
+                if constexpr (Traced) trace(TraceEventKind::branch, cellIndex, values[i] + 1);
+                profiled<Profiled>(options, ProfiledKernel::seededBranch, [&]() { boards.emplace_back(workingBoard).setSolved(cellIndex, values[i]); });
+            }
+            if constexpr (Traced) nextNode(valueCount);
             boards.pop_front();
         }
         else {
+            [[maybe_unused]] size_t children = 0;
             for (auto iter = workingBoard.possibleSolutionsBegin(result.bestIndex); iter != workingBoard.possibleSolutionsEnd(); ++iter) {
-                boards.emplace_back(std::move(*iter));
+                boards.emplace_back(profiled<Profiled>(options, ProfiledKernel::branch, [&]() { return *iter; }));
+                if constexpr (Traced) {
+                    trace(TraceEventKind::branch, result.bestIndex, boards.back().getSolvedValue(result.bestIndex));
+                    ++children;
+                }
             }
+            if constexpr (Traced) nextNode(children);
             boards.pop_front();
         }
     }
 
+    return SolveStatus::unsolvable;
+}
+
+} // namespace
+
+SolveStatus solveInto(const Board& board, Board& solved, std::deque<Board>& boards, const SolveOptions& options, SolveStats& stats) {
+    if (options.engine == SolveEngine::bitboard) {
+        return solveBitboard(board, solved, options, stats);
+    }
+
+    // recording would skew the counters, so a traced search isn't profiled
+    if constexpr (TRACE_ENABLED) {
+        if (options.trace) {
+            return options.seed == 0
+                ? search<false, false, true>(board, solved, boards, options, stats)
+                : search<true, false, true>(board, solved, boards, options, stats);
+        }
+    }
+
+    if (options.profile) {
+        return withCounters(*options.profile, ProfiledKernel::solveLoop, [&]() {
+            return options.seed == 0
+                ? search<false, true, false>(board, solved, boards, options, stats)
+                : search<true, true, false>(board, solved, boards, options, stats);
+        });
+    }
+
+    if (options.seed == 0) {
+        return search<false, false, false>(board, solved, boards, options, stats);
+    }
+    else {
+        return search<true, false, false>(board, solved, boards, options, stats);
+    }
+}
+
+
+bool solveInto(const Board& board, Board& solved, std::deque<Board>& boards) {
+    SolveStats stats;
+    return solveInto(board, solved, boards, SolveOptions{}, stats) == SolveStatus::solved;
+}
+
+SolveResult solve(const Board& board, const SolveOptions& options) {
+    std::deque<Board> boards;
+    SolveResult result;
+    result.status = solveInto(board, result.board, boards, options, result.stats);
+    return result;
+}
+
+std::optional<Board> solve(const Board& board) {
+    std::deque<Board> boards;
+    Board solved;
+    if (solveInto(board, solved, boards)) {
+        return {solved};
+    }
     return std::nullopt;
-}
\ No newline at end of file
+}
@@ -0,0 +1,32 @@
+#include "susolv/batch.h"
+#include "susolv/susolv.h"
+#include "susolv/verify.h"
+
+static_assert(static_cast<uint8_t>(BatchStatus::solved) == SUSOLV_SOLVED);
+static_assert(static_cast<uint8_t>(BatchStatus::unsolvable) == SUSOLV_UNSOLVABLE);
+static_assert(static_cast<uint8_t>(BatchStatus::invalidInput) == SUSOLV_INVALID_INPUT);
+static_assert(sizeof(BatchStatus) == sizeof(uint8_t));
+static_assert(BOARD_CELLS == SUSOLV_BOARD_CELLS);
+static_assert(static_cast<uint8_t>(VerifyStatus::valid) == SUSOLV_VERIFY_VALID);
+static_assert(static_cast<uint8_t>(VerifyStatus::malformed) == SUSOLV_VERIFY_MALFORMED);
+static_assert(static_cast<uint8_t>(VerifyStatus::clueMismatch) == SUSOLV_VERIFY_CLUE_MISMATCH);
+static_assert(static_cast<uint8_t>(VerifyStatus::unitViolation) == SUSOLV_VERIFY_UNIT_VIOLATION);
+static_assert(sizeof(VerifyStatus) == sizeof(uint8_t));
+
+extern "C" size_t susolv_solve_batch(const char* puzzles, char* solutions, uint8_t* statuses, size_t count) {
+    return solveBatch(puzzles, solutions, reinterpret_cast<BatchStatus*>(statuses), count);
+}
+
+extern "C" int susolv_solve(const char* puzzle, char* solution) {
+    BatchStatus status;
+    solveBatch(puzzle, solution, &status, 1);
+    return static_cast<int>(status);
+}
+
+extern "C" size_t susolv_verify_batch(const char* puzzles, const char* grids, uint8_t* statuses, size_t count) {
+    return verifyBatch(puzzles, grids, reinterpret_cast<VerifyStatus*>(statuses), count);
+}
+
+extern "C" int susolv_verify(const char* puzzle, const char* grid) {
+    return static_cast<int>(verifySolution(puzzle, grid));
+}
@@ -0,0 +1,165 @@
+#include <fstream>
+#include <iostream>
+
+#include "susolv/multiGrid.h"
+
+GridWorkers::GridWorkers(unsigned threads) :
+    start_(std::max(threads, 1u)),
+    done_(std::max(threads, 1u))
+{
+    for (unsigned i = 1; i < threads; ++i) {
+        threads_.emplace_back([this]() { work(); });
+    }
+}
+
+GridWorkers::~GridWorkers() {
+    stopping_.store(true, std::memory_order_relaxed);
+    // the barrier orders the store before the workers' loads, and lets them see it and return
+    start_.arrive_and_wait();
+    // join here, while the barriers and the flag the workers touch are still alive
+    for (std::jthread& thread : threads_) {
+        thread.join();
+    }
+}
+
+void GridWorkers::run(size_t count, const std::function<void(size_t)>& job) {
+    if (threads_.empty()) {
+        for (size_t i = 0; i < count; ++i) {
+            job(i);
+        }
+        return;
+    }
+
+    job_ = &job;
+    count_ = count;
+    next_.store(0, std::memory_order_relaxed);
+
+    start_.arrive_and_wait();
+    drain();
+    done_.arrive_and_wait();
+}
+
+void GridWorkers::work() {
+    while (true) {
+        start_.arrive_and_wait();
+        if (stopping_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        drain();
+        done_.arrive_and_wait();
+    }
+}
+
+void GridWorkers::drain() {
+    for (size_t i = next_.fetch_add(1, std::memory_order_relaxed); i < count_; i = next_.fetch_add(1, std::memory_order_relaxed)) {
+        (*job_)(i);
+    }
+}
+
+bool parseSamurai(const std::vector<std::string>& rows, SamuraiBoard& board) {
+    const SamuraiBoard::Layout& layout = *board.layout;
+    if (rows.size() != layout.height) {
+        return false;
+    }
+
+    auto at = [&](int row, int col) {
+        return static_cast<size_t>(col) < rows[row].size() ? rows[row][col] : ' ';
+    };
+
+    board = SamuraiBoard(layout);
+
+    bool inGrid[SAMURAI_LAYOUT.height][SAMURAI_LAYOUT.width] = {};
+    for (size_t grid = 0; grid < SamuraiBoard::Layout::GRID_COUNT; ++grid) {
+        for (uint8_t cell = 0; cell < 81; ++cell) {
+            const int row = layout.canvasRow(grid, cell);
+            const int col = layout.canvasCol(grid, cell);
+            inGrid[row][col] = true;
+
+            const char c = at(row, col);
+            if (c == '0' || c == '.' || board.isSolved(grid, cell)) {
+                continue; // an overlap cell is seen once from each grid
+            }
+            if (c < '1' || c > '9') {
+                return false;
+            }
+
+            const uint8_t bitIndex = static_cast<uint8_t>(c - '1');
+            if (!(board.availableValues(grid, cell) & (1 << bitIndex))) {
+                return false;
+            }
+            board.setSolved(grid, cell, bitIndex);
+        }
+    }
+
+    for (int row = 0; row < layout.height; ++row) {
+        if (rows[row].size() > layout.width) {
+            return false;
+        }
+        for (int col = 0; col < layout.width; ++col) {
+            if (!inGrid[row][col] && at(row, col) != ' ') {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+std::vector<SamuraiBoard> loadSamuraiBoards(const char* fname) {
+    std::ifstream f(fname);
+
+    if (!f) {
+        std::cout << "Can't open " << fname << std::endl;
+        std::terminate();
+    }
+
+    std::vector<SamuraiBoard> boards;
+    std::vector<std::string> rows;
+    std::string line;
+    size_t lineNumber = 0;
+
+    while (std::getline(f, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        rows.push_back(line);
+        if (rows.size() == SAMURAI_LAYOUT.height) {
+            SamuraiBoard board(SAMURAI_LAYOUT);
+            if (parseSamurai(rows, board)) {
+                boards.push_back(board);
+            }
+            else {
+                std::cout << fname << ":" << lineNumber << ": malformed samurai puzzle, skipped" << std::endl;
+            }
+            rows.clear();
+        }
+    }
+
+    if (!rows.empty()) {
+        std::cout << fname << ": " << rows.size() << " trailing lines, skipped" << std::endl;
+    }
+
+    return boards;
+}
+
+void writeSamurai(const SamuraiBoard& board, std::ostream& out) {
+    const SamuraiBoard::Layout& layout = *board.layout;
+    std::vector<std::string> rows(layout.height, std::string(layout.width, ' '));
+
+    for (size_t grid = 0; grid < SamuraiBoard::Layout::GRID_COUNT; ++grid) {
+        for (uint8_t cell = 0; cell < 81; ++cell) {
+            rows[layout.canvasRow(grid, cell)][layout.canvasCol(grid, cell)] =
+                board.isSolved(grid, cell) ? static_cast<char>('0' + board.getSolvedValue(grid, cell)) : '.';
+        }
+    }
+
+    for (std::string& row : rows) {
+        row.erase(row.find_last_not_of(' ') + 1);
+        out << row << "\n";
+    }
+}
@@ -0,0 +1,171 @@
+#include <cerrno>
+#include <cstring>
+
+#include "susolv/perfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const char* perfCounterName(PerfCounter counter) {
+    switch (counter) {
+        case PerfCounter::cycles:       return "cycles";
+        case PerfCounter::instructions: return "instructions";
+        case PerfCounter::branchMisses: return "branch-misses";
+        case PerfCounter::l1dMisses:    return "L1d-misses";
+        case PerfCounter::llcMisses:    return "LLC-misses";
+        default:                        return "?";
+    }
+}
+
+const char* profiledKernelName(ProfiledKernel kernel) {
+    switch (kernel) {
+        case ProfiledKernel::solveLoop:            return "solve loop";
+        case ProfiledKernel::fullComputeTakenVals: return "fullComputeTakenVals";
+        case ProfiledKernel::simpleSolve:          return "simpleSolve";
+        case ProfiledKernel::branch:               return "PossibleSolutionIterator::operator*";
+        case ProfiledKernel::seededBranch:         return "seeded branch (Board copy + setSolved)";
+        default:                                   return "?";
+    }
+}
+
+bool PerfCounterGroup::has(PerfCounter counter) const {
+    for (uint8_t i = 0; i < opened_; ++i) {
+        if (order_[i] == counter) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef __linux__
+
+namespace {
+
+perf_event_attr attrFor(PerfCounter counter) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    auto cache = [](uint64_t cache, uint64_t op, uint64_t result) {
+        return cache | (op << 8) | (result << 16);
+    };
+
+    switch (counter) {
+        case PerfCounter::cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfCounter::instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfCounter::branchMisses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PerfCounter::l1dMisses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS);
+            break;
+        case PerfCounter::llcMisses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS);
+            break;
+        default:
+            break;
+    }
+
+    return attr;
+}
+
+} // namespace
+
+PerfCounterGroup::PerfCounterGroup() {
+    int leader = -1;
+
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        const PerfCounter counter = static_cast<PerfCounter>(i);
+        perf_event_attr attr = attrFor(counter);
+        attr.disabled = leader == -1 ? 1 : 0;
+
+        const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+        if (fd == -1) {
+            // without a leader yet, the next counter that opens leads instead; keep the first reason in case none does
+            if (leader == -1 && unavailableReason_.empty()) {
+                unavailableReason_ = std::string("perf_event_open(") + perfCounterName(counter) + "): " + std::strerror(errno);
+                if (errno == EACCES || errno == EPERM) {
+                    unavailableReason_ += " (see /proc/sys/kernel/perf_event_paranoid)";
+                }
+            }
+            continue;
+        }
+
+        if (leader == -1) {
+            leader = fd;
+        }
+        fds_[opened_] = fd;
+        order_[opened_] = counter;
+        ++opened_;
+    }
+
+    if (leader == -1) {
+        return;
+    }
+    unavailableReason_.clear();
+
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounterGroup::~PerfCounterGroup() {
+    for (uint8_t i = 0; i < opened_; ++i) {
+        close(fds_[i]);
+    }
+}
+
+CounterSample PerfCounterGroup::read() const {
+    CounterSample sample;
+    if (opened_ == 0) {
+        return sample;
+    }
+
+    struct {
+        uint64_t nr;
+        uint64_t timeEnabled;
+        uint64_t timeRunning;
+        uint64_t values[PERF_COUNTER_COUNT];
+    } data;
+
+    if (::read(fds_[0], &data, sizeof(data)) <= 0 || data.timeRunning == 0) {
+        return sample;
+    }
+
+    for (uint64_t i = 0; i < data.nr && i < opened_; ++i) {
+        uint64_t value = data.values[i];
+        if (data.timeRunning < data.timeEnabled) {
+            value = static_cast<uint64_t>(static_cast<double>(value) * data.timeEnabled / data.timeRunning);
+        }
+        sample.values[static_cast<size_t>(order_[i])] = value;
+    }
+
+    return sample;
+}
+
+#else
+
+PerfCounterGroup::PerfCounterGroup() : unavailableReason_("hardware counters are only read on linux") {}
+
+PerfCounterGroup::~PerfCounterGroup() {}
+
+CounterSample PerfCounterGroup::read() const {
+    return {};
+}
+
+#endif
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "susolv/portfolio.h"
+
+namespace {
+
+// seed, seed + 1, ..., stepping over 0 (the unseeded, fixed order search) if that wraps
+uint64_t racerSeed(uint64_t seed, unsigned racer) {
+    const uint64_t raw = seed + racer;
+    return seed == 0 || raw < seed ? raw + 1 : raw;
+}
+
+} // namespace
+
+SolveResult solvePortfolio(const Board& board, const PortfolioOptions& options) {
+    SolveOptions plain = options.limits;
+    plain.seed = 0;
+    plain.nodeBudget = std::min(options.nodeThreshold, options.limits.nodeBudget);
+
+    SolveResult result = solve(board, plain);
+
+    // anything but running out of the threshold is final, as is running out of the caller's own budget
+    const bool hitThreshold = result.status == SolveStatus::timedOut
+        && result.stats.nodes >= options.nodeThreshold
+        && options.nodeThreshold < options.limits.nodeBudget;
+
+    if (!hitThreshold || options.workers == 0) {
+        return result;
+    }
+
+    std::stop_source race;
+    // a stop on the caller's token stops the whole race
+    std::stop_callback forwardStop(options.limits.stopToken, [&race]() { race.request_stop(); });
+
+    std::mutex mutex;
+    std::optional<SolveResult> winner;
+    std::vector<SolveStats> workerStats(options.workers);
+
+    // what's left of the caller's budget after the plain phase, split evenly so the racers together stay within it
+    const uint64_t racerBudget = options.limits.nodeBudget == UINT64_MAX
+        ? UINT64_MAX
+        : (options.limits.nodeBudget - result.stats.nodes) / options.workers;
+
+    auto racer = [&](unsigned i) {
+        SolveOptions worker = options.limits;
+        worker.stopToken = race.get_token();
+        // the plain phase already went down the fixed order, so every racer is seeded; and only
+        // the cell-major search honors a seed
+        worker.seed = racerSeed(options.seed, i);
+        worker.engine = SolveEngine::cellMajor;
+        // profiles and traces belong to the calling thread
+        worker.profile = nullptr;
+        worker.trace = nullptr;
+        worker.nodeBudget = racerBudget;
+
+        std::deque<Board> boards;
+        Board solved;
+        const SolveStatus status = solveInto(board, solved, boards, worker, workerStats[i]);
+
+        if (status == SolveStatus::solved || status == SolveStatus::unsolvable) {
+            std::lock_guard lock(mutex);
+            if (!winner) {
+                winner = SolveResult{ .status = status, .stats = {}, .board = solved };
+                race.request_stop();
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(options.workers);
+
+        try {
+            for (unsigned i = 0; i < options.workers; ++i) {
+                threads.emplace_back(racer, i);
+            }
+        }
+        catch (...) {
+            // the racers already running only stop on the race's token; jthread's own stop doesn't reach them
+            race.request_stop();
+            throw;
+        }
+    }
+
+    SolveStats total = result.stats;
+    for (const SolveStats& stats : workerStats) {
+        total.nodes += stats.nodes;
+        total.maxQueue = std::max(total.maxQueue, stats.maxQueue);
+    }
+
+    if (winner) {
+        result = *winner;
+    }
+    else {
+        result.status = options.limits.stopToken.stop_requested() ? SolveStatus::cancelled : SolveStatus::timedOut;
+    }
+    result.stats = total;
+
+    return result;
+}
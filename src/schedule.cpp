@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <queue>
+#include <thread>
+
+#include "susolv/schedule.h"
+
+namespace {
+
+using clock = SolveOptions::clock;
+
+// log2(1..9), so the probe doesn't call log2 per cell
+constexpr float LOG2_COUNT[10] = { 0.f, 0.f, 1.f, 1.5849625f, 2.f, 2.3219281f, 2.5849625f, 2.8073549f, 3.f, 3.169925f };
+
+// least squares fit of log2(cellMajor nodes) against entropy over euler96, 17clue and hard.txt;
+// entropy alone ranks those about as well as anything else the probe sees (spearman 0.82)
+constexpr float PREDICT_SLOPE = 0.1075f;
+constexpr float PREDICT_INTERCEPT = -2.98f;
+
+float predictNodes(const PuzzleProbe& probe) {
+    if (probe.settled) {
+        return 1.f;
+    }
+    return std::exp2(PREDICT_SLOPE * probe.entropy + PREDICT_INTERCEPT);
+}
+
+} // namespace
+
+PuzzleProbe probePuzzle(const Board& board) {
+    PuzzleProbe probe;
+    Board work = board;
+
+    probe.clues = static_cast<uint8_t>(std::popcount(work.solvedIndices.b1) + std::popcount(work.solvedIndices.b2));
+    work.fullComputeTakenVals();
+    const Board::SimpleSolveResult result = work.simpleSolve();
+    probe.settled = result.solved || result.invalid;
+
+    if (!probe.settled) {
+        uint8_t index = 0;
+        while (true) {
+            index = work.solvedIndices.nextUnsolvedOnOrAfter(index);
+            if (index >= 81) {
+                break;
+            }
+            ++probe.unsolved;
+            probe.entropy += LOG2_COUNT[std::popcount(work.availableValuesForCell(index))];
+            ++index;
+        }
+    }
+
+    probe.predictedNodes = predictNodes(probe);
+    return probe;
+}
+
+void solveScheduled(const std::vector<Board>& boards, std::vector<Board>& solved, const ScheduleOptions& options, ScheduleReport& report) {
+    const size_t count = boards.size();
+    solved.resize(count);
+    report.puzzles.assign(count, {});
+    report.order.resize(count);
+    std::iota(report.order.begin(), report.order.end(), size_t{ 0 });
+
+    const clock::time_point probeStart = clock::now();
+    if (options.order == BatchOrder::longestPredictedFirst) {
+        for (size_t i = 0; i < count; ++i) {
+            report.puzzles[i].probe = probePuzzle(boards[i]);
+        }
+        // stable, so equal predictions keep their input order
+        std::stable_sort(report.order.begin(), report.order.end(), [&](size_t a, size_t b) {
+            return report.puzzles[a].probe.predictedNodes > report.puzzles[b].probe.predictedNodes;
+        });
+    }
+    const clock::time_point solveStart = clock::now();
+    report.probeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(solveStart - probeStart).count();
+
+    const unsigned workers = std::max(1u, options.workers);
+
+    // a KernelProfile or SearchTrace belongs to the calling thread; workers of their own get neither
+    SolveOptions solve = options.solve;
+    if (workers > 1) {
+        solve.profile = nullptr;
+        solve.trace = nullptr;
+    }
+
+    std::atomic<size_t> next = 0;
+    auto work = [&](unsigned worker) {
+        std::deque<Board> queue;
+        for (size_t slot = next.fetch_add(1, std::memory_order_relaxed); slot < count; slot = next.fetch_add(1, std::memory_order_relaxed)) {
+            const size_t i = report.order[slot];
+            ScheduledSolve& puzzle = report.puzzles[i];
+            SolveStats stats;
+
+            const clock::time_point start = clock::now();
+            puzzle.status = solveInto(boards[i], solved[i], queue, solve, stats);
+            puzzle.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+            puzzle.nodes = stats.nodes;
+            puzzle.worker = worker;
+        }
+    };
+
+    if (workers == 1) {
+        work(0);
+    }
+    else {
+        std::vector<std::jthread> threads;
+        threads.reserve(workers);
+        for (unsigned worker = 0; worker < workers; ++worker) {
+            threads.emplace_back(work, worker);
+        }
+    }
+
+    report.makespanNs = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - solveStart).count();
+}
+
+double listScheduleMakespan(const std::vector<double>& costs, const std::vector<size_t>& order, unsigned workers) {
+    // when each worker is next free, soonest on top
+    std::priority_queue<double, std::vector<double>, std::greater<double>> freeAt;
+    for (unsigned i = 0; i < std::max(1u, workers); ++i) {
+        freeAt.push(0.0);
+    }
+
+    double makespan = 0.0;
+    for (size_t i : order) {
+        const double done = freeAt.top() + costs[i];
+        freeAt.pop();
+        freeAt.push(done);
+        makespan = std::max(makespan, done);
+    }
+    return makespan;
+}
+
+SchedulePool::SchedulePool(const ScheduleOptions& options) :
+    order_(options.order),
+    solve_(options.solve),
+    forwardStop_(options.solve.stopToken, [this]() { cancel_.request_stop(); })
+{
+    // a KernelProfile or SearchTrace belongs to the calling thread
+    solve_.profile = nullptr;
+    solve_.trace = nullptr;
+    solve_.stopToken = cancel_.get_token();
+
+    const unsigned workers = std::max(1u, options.workers);
+    threads_.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+        threads_.emplace_back([this](std::stop_token stop) { work(stop); });
+    }
+}
+
+SchedulePool::~SchedulePool() {
+    cancel_.request_stop();
+    for (std::jthread& thread : threads_) {
+        thread.request_stop();
+    }
+    for (std::jthread& thread : threads_) {
+        thread.join();
+    }
+}
+
+void SchedulePool::submit(uint64_t ticket, const Board& board) {
+    const float priority = order_ == BatchOrder::longestPredictedFirst ? probePuzzle(board).predictedNodes : 0.f;
+    {
+        std::lock_guard lock(mutex_);
+        pending_.push({ priority, ticket, board });
+    }
+    ++outstanding_;
+    queued_.notify_one();
+}
+
+void SchedulePool::collect(std::vector<PooledSolve>& done) {
+    if (outstanding_ == 0) {
+        return;
+    }
+
+    std::unique_lock lock(mutex_);
+    finished_.wait(lock, [this]() { return !done_.empty(); });
+    outstanding_ -= done_.size();
+    done.insert(done.end(), std::make_move_iterator(done_.begin()), std::make_move_iterator(done_.end()));
+    done_.clear();
+}
+
+void SchedulePool::work(std::stop_token stop) {
+    std::deque<Board> queue; // search scratch, kept for its storage
+    PooledSolve result;
+
+    while (true) {
+        Board board;
+        {
+            std::unique_lock lock(mutex_);
+            if (!queued_.wait(lock, stop, [this]() { return !pending_.empty(); })) {
+                return;
+            }
+            board = pending_.top().board;
+            result.ticket = pending_.top().ticket;
+            pending_.pop();
+        }
+
+        SolveStats stats;
+        result.status = solveInto(board, result.solved, queue, solve_, stats);
+        result.nodes = stats.nodes;
+
+        {
+            std::lock_guard lock(mutex_);
+            done_.push_back(result);
+        }
+        finished_.notify_one();
+    }
+}
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+
+#include "susolv/searchTrace.h"
+
+namespace {
+
+constexpr char TRACE_MAGIC[8] = { 'S', 'U', 'S', 'T', 'R', 'A', 'C', 'E' };
+constexpr uint32_t TRACE_VERSION = 1;
+
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t eventSize;
+    uint64_t recorded;
+    uint64_t dropped;
+    uint64_t count;
+};
+
+TraceHeader headerFor(uint64_t recorded, uint64_t dropped, uint64_t count) {
+    TraceHeader header{};
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.eventSize = sizeof(TraceEvent);
+    header.recorded = recorded;
+    header.dropped = dropped;
+    header.count = count;
+    return header;
+}
+
+} // namespace
+
+SearchTrace::SearchTrace(size_t capacity) :
+    ring_(std::bit_ceil(capacity < 1 ? size_t{ 1 } : capacity)),
+    mask_(ring_.size() - 1)
+{}
+
+SearchTrace::SearchTrace(const char* fname, size_t capacity) : SearchTrace(capacity) {
+    sink_ = fopen(fname, "wb");
+    // the header is rewritten on every flush, so a trace cut short by a crash still reads up to the last one
+    const TraceHeader header = headerFor(0, 0, 0);
+    ok_ = sink_ != NULL && fwrite(&header, sizeof(header), 1, sink_) == 1 && fflush(sink_) == 0;
+}
+
+SearchTrace::~SearchTrace() {
+    if (sink_ != nullptr) {
+        flush();
+        fclose(sink_);
+    }
+}
+
+void SearchTrace::spill() {
+    // the unwritten events are a run of the ring that may wrap past its end once
+    while (written_ < recorded_) {
+        const size_t from = written_ & mask_;
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(recorded_ - written_, ring_.size() - from));
+        ok_ = ok_ && fwrite(&ring_[from], sizeof(TraceEvent), count, sink_) == count;
+        written_ += count;
+    }
+}
+
+bool SearchTrace::flush() {
+    if (sink_ == nullptr) {
+        return ok_;
+    }
+
+    spill();
+    const TraceHeader header = headerFor(written_, 0, written_);
+    ok_ = ok_
+        && fseek(sink_, 0, SEEK_SET) == 0
+        && fwrite(&header, sizeof(header), 1, sink_) == 1
+        && fseek(sink_, 0, SEEK_END) == 0
+        && fflush(sink_) == 0;
+    return ok_;
+}
+
+std::vector<TraceEvent> SearchTrace::events() const {
+    std::vector<TraceEvent> result;
+    const uint64_t count = recorded_ - std::max(dropped(), written_);
+    result.reserve(count);
+    for (uint64_t i = recorded_ - count; i < recorded_; ++i) {
+        result.push_back(ring_[i & mask_]);
+    }
+    return result;
+}
+
+bool SearchTrace::writeFile(const char* fname) const {
+    FILE* f = fopen(fname, "wb");
+    if (f == NULL) {
+        return false;
+    }
+
+    const std::vector<TraceEvent> ordered = events();
+    const TraceHeader header = headerFor(recorded_, dropped(), ordered.size());
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    ok = ok && fwrite(ordered.data(), sizeof(TraceEvent), ordered.size(), f) == ordered.size();
+    return fclose(f) == 0 && ok;
+}
+
+bool readTraceFile(const char* fname, TraceFile& trace) {
+    FILE* f = fopen(fname, "rb");
+    if (f == NULL) {
+        return false;
+    }
+
+    TraceHeader header;
+    bool ok = fread(&header, sizeof(header), 1, f) == 1
+        && std::memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0
+        && header.version == TRACE_VERSION
+        && header.eventSize == sizeof(TraceEvent)
+        && header.count <= header.recorded;
+
+    if (ok) {
+        trace.recorded = header.recorded;
+        trace.dropped = header.dropped;
+        trace.events.resize(header.count);
+        ok = fread(trace.events.data(), sizeof(TraceEvent), header.count, f) == header.count;
+    }
+
+    fclose(f);
+    return ok;
+}
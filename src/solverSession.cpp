@@ -0,0 +1,180 @@
+#include "susolv/solverSession.h"
+
+namespace {
+
+EditStatus toEditStatus(SolveStatus status) {
+    switch (status) {
+        case SolveStatus::solved:    return EditStatus::solved;
+        case SolveStatus::timedOut:  return EditStatus::timedOut;
+        case SolveStatus::cancelled: return EditStatus::cancelled;
+        default:                     return EditStatus::unsolvable;
+    }
+}
+
+// the three units of a cell as indices into SolverSession::duplicates_
+void unitsOf(uint8_t cellIndex, uint8_t (&units)[3]) {
+    units[0] = cellIndexLookup.indexToRow[cellIndex];
+    units[1] = 9 + cellIndexLookup.indexToCol[cellIndex];
+    units[2] = 18 + cellIndexLookup.indexToQuad[cellIndex];
+}
+
+const uint8_t* unitCells(uint8_t unit) {
+    if (unit < 9) return cellIndexLookup.rowElementIndices[unit];
+    if (unit < 18) return cellIndexLookup.colElementIndices[unit - 9];
+    return cellIndexLookup.quadElementIndices[unit - 18];
+}
+
+} // namespace
+
+SolverSession::SolverSession(const Board& clues, const SolveOptions& options) : clues_(clues), options_(options) {
+    for (uint8_t unit = 0; unit < 27; ++unit) {
+        const uint8_t* cells = unitCells(unit);
+        uint16_t taken = 0;
+        for (int i = 0; i < 9; ++i) {
+            if (clues_.isSolved(cells[i])) {
+                const uint16_t bit = clues_.cells[cells[i]] & Board::ALL_VALUES_MASK;
+                duplicates_[unit] += (taken & bit) != 0;
+                taken |= bit;
+            }
+        }
+        duplicateTotal_ += duplicates_[unit];
+    }
+
+    clues_.fullComputeTakenVals();
+    last_ = duplicateTotal_ > 0 ? EditResult{ .status = EditStatus::contradiction } : resolve(0xFF);
+}
+
+void SolverSession::recomputeUnits(uint8_t cellIndex) {
+    uint8_t units[3];
+    unitsOf(cellIndex, units);
+
+    uint16_t taken[3] = { Board::TAKEN_INIT, Board::TAKEN_INIT, Board::TAKEN_INIT };
+
+    for (int u = 0; u < 3; ++u) {
+        const uint8_t* cells = unitCells(units[u]);
+        uint8_t duplicates = 0;
+        for (int i = 0; i < 9; ++i) {
+            if (clues_.isSolved(cells[i])) {
+                const uint16_t bit = clues_.cells[cells[i]] & Board::ALL_VALUES_MASK;
+                duplicates += (taken[u] & bit) != 0;
+                taken[u] |= bit;
+            }
+        }
+        duplicateTotal_ += duplicates - duplicates_[units[u]];
+        duplicates_[units[u]] = duplicates;
+    }
+
+    clues_.takenValues.row[units[0]] = taken[0];
+    clues_.takenValues.col[units[1] - 9] = taken[1];
+    clues_.takenValues.quad[units[2] - 18] = taken[2];
+}
+
+bool SolverSession::peersHaveCandidates(uint8_t cellIndex) const {
+    uint8_t units[3];
+    unitsOf(cellIndex, units);
+
+    for (uint8_t unit : units) {
+        const uint8_t* cells = unitCells(unit);
+        for (int i = 0; i < 9; ++i) {
+            if (!clues_.isSolved(cells[i]) && clues_.availableValuesForCell(cells[i]) == 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+EditResult SolverSession::resolve(uint8_t editedIndex) {
+    EditResult result;
+
+    if (hasSolution_ && editedIndex < 81) {
+        // keep the old solution everywhere the edit can't have reached directly
+        Board warm = clues_;
+        const uint8_t row = cellIndexLookup.indexToRow[editedIndex];
+        const uint8_t col = cellIndexLookup.indexToCol[editedIndex];
+        const uint8_t quad = cellIndexLookup.indexToQuad[editedIndex];
+
+        for (uint8_t i = 0; i < 81; ++i) {
+            const bool affected = cellIndexLookup.indexToRow[i] == row
+                || cellIndexLookup.indexToCol[i] == col
+                || cellIndexLookup.indexToQuad[i] == quad;
+            // a value the current clues rule out would never be caught, since solved cells aren't rechecked
+            const uint8_t bitIndex = solution_.getSolvedValue(i) - 1;
+            if (!affected && !warm.isSolved(i) && (warm.availableValuesForCell(i) & (1 << bitIndex))) {
+                warm.setSolved(i, bitIndex);
+            }
+        }
+
+        const SolveStatus status = solveInto(warm, solution_, boards_, options_, result.stats);
+        if (status == SolveStatus::solved) {
+            result.status = EditStatus::solved;
+            hasSolution_ = true;
+            return result;
+        }
+        if (status != SolveStatus::unsolvable) {
+            // out of time or cancelled; a cold solve would be too
+            result.status = toEditStatus(status);
+            return result;
+        }
+    }
+
+    // solution_ is only written on success, so a failed search leaves the last good grid in place
+    result.status = toEditStatus(solveInto(clues_, solution_, boards_, options_, result.stats));
+    hasSolution_ = hasSolution_ || result.status == EditStatus::solved;
+    return result;
+}
+
+bool SolverSession::solutionFitsClues() const {
+    if (!hasSolution_) {
+        return false;
+    }
+    for (uint8_t i = 0; i < 81; ++i) {
+        if (clues_.isSolved(i) && clues_.getSolvedValue(i) != solution_.getSolvedValue(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+EditResult SolverSession::placeClue(uint8_t index, uint8_t value) {
+    if (index >= 81 || value < 1 || value > 9) {
+        return { .status = EditStatus::outOfRange };
+    }
+
+    clues_.setSolved(index, value - 1);
+    recomputeUnits(index);
+
+    if (duplicateTotal_ > 0 || !peersHaveCandidates(index)) {
+        last_ = { .status = EditStatus::contradiction };
+    }
+    else if (solutionFitsClues()) {
+        last_ = { .status = EditStatus::solved, .reused = true };
+    }
+    else {
+        last_ = resolve(index);
+    }
+
+    return last_;
+}
+
+EditResult SolverSession::removeClue(uint8_t index) {
+    if (index >= 81) {
+        return { .status = EditStatus::outOfRange };
+    }
+
+    clues_.setUnknown(index);
+    clues_.solvedIndices.setUnsolved(index);
+    recomputeUnits(index);
+
+    if (duplicateTotal_ > 0) {
+        last_ = { .status = EditStatus::contradiction };
+    }
+    else if (solutionFitsClues()) {
+        last_ = { .status = EditStatus::solved, .reused = true };
+    }
+    else {
+        last_ = resolve(index);
+    }
+
+    return last_;
+}
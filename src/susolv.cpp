@@ -1,53 +1,67 @@
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <optional>
 #include <vector>
 
+#include "susolv/batchRunner.h"
 #include "susolv/board.h"
 #include "susolv/euler96.h"
+#include "susolv/timing.h"
 
-using elapsed_t = decltype(std::chrono::high_resolution_clock::now() - std::chrono::high_resolution_clock::now());
+// susolv batch <input> <output> [checkpoint] [--every N] [--sync]
+int runBatchMode(int argc, char** argv) {
+    BatchRunOptions options;
+    int positional = 0;
 
-template<typename T>
-struct TimedResult {
-    T result;
-    elapsed_t elapsed;
-};
-
-template<>
-struct TimedResult<void> {
-    elapsed_t elapsed;
-};
-
-template<typename F>
-auto withTime(F&& f) -> TimedResult<decltype(f())> {
-    constexpr bool IS_VOID = std::is_same_v<decltype(f()), void>;
-    auto start = std::chrono::high_resolution_clock::now();
-
-    auto result = [&f]() {
-        if constexpr (IS_VOID) {
-            return f(), 0;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--every") == 0 && i + 1 < argc) {
+            options.checkpointEvery = std::strtoull(argv[++i], nullptr, 10);
         }
-        else {
-            return f();
+        else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            options.workers = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
         }
-    }();
-
-    auto end = std::chrono::high_resolution_clock::now();
+        else if (std::strcmp(argv[i], "--sync") == 0) {
+            options.sync = true;
+        }
+        else if (positional == 0) {
+            options.inputPath = argv[i], ++positional;
+        }
+        else if (positional == 1) {
+            options.outputPath = argv[i], ++positional;
+        }
+        else if (positional == 2) {
+            options.checkpointPath = argv[i], ++positional;
+        }
+    }
 
-    if constexpr (IS_VOID) {
-        return { .elapsed = end - start };
+    if (positional < 2) {
+        std::cerr << "usage: susolv batch <input> <output> [checkpoint] [--every N] [--workers N] [--sync]" << std::endl;
+        return 2;
     }
-    else {
-        return {
-            .result = result,
-            .elapsed = end - start
-        };
+
+    BatchRunStats stats;
+    auto [ok, elapsed] = withTime([&]() { return runBatch(options, stats); });
+    if (!ok) {
+        return 1;
     }
+
+    std::cout << (stats.resumed ? "Resumed, " : "") << stats.completed << " puzzles: "
+        << stats.solved << " solved, " << stats.unsolvable << " unsolvable, "
+        << stats.invalid << " invalid, " << stats.timedOut << " timed out\n";
+    std::cout << "  " << stats.nodes << " nodes, "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << "ms this run\n";
+    return 0;
 }
 
-int main() {
-    auto [boards, file_elapsed] = withTime([]() { return loadEuler96("c:\\users\\anon\\dev\\susolv\\boards\\euler96-all.txt"); });
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "batch") == 0) {
+        return runBatchMode(argc, argv);
+    }
+
+    const char* fname = argc > 1 ? argv[1] : SUSOLV_BOARDS_DIR "euler96-all.txt";
+    auto [boards, file_elapsed] = withTime([fname]() { return loadEuler96(fname); });
 
     std::cout << "Loaded " << boards.size() << " boards..." << std::endl;
 
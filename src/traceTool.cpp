@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "susolv/batch.h"
+#include "susolv/board.h"
+#include "susolv/searchTrace.h"
+
+static_assert(TRACE_ENABLED, "susolv_trace records through the search, so needs -DSUSOLV_TRACE=ON");
+
+/**
+ * susolv_trace record <puzzles> <out.trace> [--capacity N] [--seed S]
+ *     solves a file of packed puzzles with tracing on, streaming every event to the trace through an
+ *     N event buffer (only built with -DSUSOLV_TRACE=ON)
+ * susolv_trace summary <trace> [--top N]
+ *     per solve outcomes, a depth histogram, and the cells branched on most
+ * susolv_trace replay <trace> [--limit N]
+ *     the events as text, indented by depth
+ */
+
+namespace {
+
+const char* kindName(TraceEventKind kind) {
+    switch (kind) {
+    case TraceEventKind::start: return "start";
+    case TraceEventKind::propagate: return "propagate";
+    case TraceEventKind::branch: return "branch";
+    case TraceEventKind::invalid: return "invalid";
+    case TraceEventKind::solved: return "solved";
+    case TraceEventKind::stopped: return "stopped";
+    }
+    return "?";
+}
+
+std::string cellName(uint8_t cell) {
+    return "r" + std::to_string(cell / 9 + 1) + "c" + std::to_string(cell % 9 + 1);
+}
+
+uint64_t flagValue(int argc, char** argv, const char* flag, uint64_t fallback) {
+    for (int i = 0; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], flag) == 0) {
+            return std::strtoull(argv[i + 1], nullptr, 10);
+        }
+    }
+    return fallback;
+}
+
+int record(int argc, char** argv) {
+    SearchTrace trace(argv[3], flagValue(argc, argv, "--capacity", 1 << 16));
+    if (!trace.ok()) {
+        std::cerr << "Can't write " << argv[3] << std::endl;
+        return 1;
+    }
+    SolveOptions options;
+    options.trace = &trace;
+    options.seed = flagValue(argc, argv, "--seed", 0);
+
+    std::deque<Board> boards;
+    Board solved;
+    SolveStats stats;
+    size_t count = 0;
+    for (const Board& board : loadPackedBoards(argv[2])) {
+        solveInto(board, solved, boards, options, stats);
+        ++count;
+    }
+
+    if (!trace.flush()) {
+        std::cerr << "Can't write " << argv[3] << std::endl;
+        return 1;
+    }
+    std::cout << count << " puzzles, " << stats.nodes << " nodes, " << trace.recorded() << " events to " << argv[3] << "\n";
+    return 0;
+}
+
+int summary(const TraceFile& trace, size_t top) {
+    struct Solve {
+        uint32_t clues = 0;
+        uint64_t nodes = 0;
+        uint32_t maxDepth = 0;
+        const char* outcome = "unsolvable";
+    };
+    struct DepthRow {
+        uint64_t nodes = 0;
+        uint64_t invalid = 0;
+        uint64_t propagated = 0;
+    };
+    struct CellRow {
+        uint64_t branches = 0;   // nodes that branched on the cell
+        uint64_t candidates = 0; // children queued over all of them
+    };
+
+    std::vector<Solve> solves;
+    std::vector<DepthRow> depths;
+    std::map<uint8_t, CellRow> cells;
+    uint64_t propagateEvents = 0;
+    uint64_t propagated = 0;
+
+    const TraceEvent* previous = nullptr;
+    for (const TraceEvent& event : trace.events) {
+        if (event.kind == TraceEventKind::start || solves.empty()) {
+            solves.push_back({});
+        }
+        Solve& solve = solves.back();
+        if (depths.size() <= event.depth) {
+            depths.resize(event.depth + 1);
+        }
+        solve.maxDepth = std::max<uint32_t>(solve.maxDepth, event.depth);
+
+        switch (event.kind) {
+        case TraceEventKind::start:
+            solve.clues = event.arg;
+            break;
+        case TraceEventKind::propagate:
+            ++solve.nodes;
+            ++depths[event.depth].nodes;
+            depths[event.depth].propagated += event.arg;
+            ++propagateEvents;
+            propagated += event.arg;
+            break;
+        case TraceEventKind::branch: {
+            CellRow& row = cells[event.cell];
+            if (previous == nullptr || previous->kind != TraceEventKind::branch || previous->node != event.node) {
+                ++row.branches;
+            }
+            ++row.candidates;
+            break;
+        }
+        case TraceEventKind::invalid:
+            ++depths[event.depth].invalid;
+            break;
+        case TraceEventKind::solved:
+            solve.outcome = "solved";
+            break;
+        case TraceEventKind::stopped:
+            solve.outcome = "stopped";
+            break;
+        }
+        previous = &event;
+    }
+
+    std::cout << trace.events.size() << " events";
+    if (trace.dropped) {
+        std::cout << " (" << trace.dropped << " older ones dropped, so the first solve is partial)";
+    }
+    std::cout << ", " << solves.size() << " solves, " << propagateEvents << " nodes\n";
+    if (propagateEvents) {
+        std::cout << "propagation solved " << std::fixed << std::setprecision(2)
+            << static_cast<double>(propagated) / propagateEvents << " cells per node\n";
+    }
+
+    std::cout << "\nsolve  clues  nodes       depth  outcome\n";
+    for (size_t i = 0; i < solves.size(); ++i) {
+        std::cout << std::setw(5) << i << "  " << std::setw(5) << solves[i].clues << "  " << std::setw(10) << solves[i].nodes
+            << "  " << std::setw(5) << solves[i].maxDepth << "  " << solves[i].outcome << "\n";
+    }
+
+    uint64_t widest = 1;
+    for (const DepthRow& row : depths) {
+        widest = std::max(widest, row.nodes);
+    }
+    std::cout << "\ndepth  nodes       invalid     cells/node\n";
+    for (size_t depth = 0; depth < depths.size(); ++depth) {
+        const DepthRow& row = depths[depth];
+        std::cout << std::setw(5) << depth << "  " << std::setw(10) << row.nodes << "  " << std::setw(10) << row.invalid << "  "
+            << std::setw(10) << (row.nodes ? static_cast<double>(row.propagated) / row.nodes : 0.0) << "  "
+            << std::string(static_cast<size_t>(40 * row.nodes / widest), '#') << "\n";
+    }
+
+    std::vector<std::pair<uint8_t, CellRow>> hottest(cells.begin(), cells.end());
+    std::sort(hottest.begin(), hottest.end(), [](const auto& a, const auto& b) { return a.second.branches > b.second.branches; });
+    hottest.resize(std::min(hottest.size(), top));
+
+    std::cout << "\ncell   branches    candidates/branch\n";
+    for (const auto& [cell, row] : hottest) {
+        std::cout << std::setw(5) << cellName(cell) << "  " << std::setw(10) << row.branches << "  "
+            << static_cast<double>(row.candidates) / row.branches << "\n";
+    }
+    return 0;
+}
+
+int replay(const TraceFile& trace, uint64_t limit) {
+    uint64_t printed = 0;
+    for (const TraceEvent& event : trace.events) {
+        if (printed++ == limit) {
+            std::cout << "... " << trace.events.size() - limit << " more\n";
+            break;
+        }
+
+        std::cout << std::string(event.depth * 2u, ' ') << "#" << event.node << " " << kindName(event.kind);
+        switch (event.kind) {
+        case TraceEventKind::start: std::cout << " " << int(event.arg) << " clues"; break;
+        case TraceEventKind::propagate: std::cout << " +" << int(event.arg); break;
+        case TraceEventKind::branch: std::cout << " " << cellName(event.cell) << "=" << int(event.arg); break;
+        default: break;
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string mode = argc > 1 ? argv[1] : "";
+
+    if (mode == "record" && argc > 3) {
+        return record(argc, argv);
+    }
+
+    if ((mode == "summary" || mode == "replay") && argc > 2) {
+        TraceFile trace;
+        if (!readTraceFile(argv[2], trace)) {
+            std::cerr << "Can't read trace " << argv[2] << std::endl;
+            return 1;
+        }
+        return mode == "summary"
+            ? summary(trace, flagValue(argc, argv, "--top", 10))
+            : replay(trace, flagValue(argc, argv, "--limit", UINT64_MAX));
+    }
+
+    std::cerr << "usage: susolv_trace record <puzzles> <out.trace> [--capacity N] [--seed S]\n"
+        << "       susolv_trace summary <trace> [--top N]\n"
+        << "       susolv_trace replay <trace> [--limit N]" << std::endl;
+    return 2;
+}
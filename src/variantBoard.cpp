@@ -0,0 +1,60 @@
+#include <cstdio>
+
+#include "susolv/variantBoard.h"
+
+bool makeJigsawTable(const uint8_t (&regionOf)[81], JigsawLayout::Table& table) {
+    table = rowsAndCols<JigsawLayout::Table>(false);
+
+    uint8_t regionSizes[9] = {};
+    for (uint8_t cell = 0; cell < 81; ++cell) {
+        const uint8_t region = regionOf[cell];
+        if (region >= 9 || regionSizes[region] == 9) {
+            return false;
+        }
+        table.unitCells[18 + region][regionSizes[region]++] = cell;
+    }
+
+    // 81 cells into 9 regions of at most 9 means every region is full
+    return table.link();
+}
+
+bool loadJigsawTable(const char* fname, JigsawLayout::Table& table) {
+    FILE* f = fopen(fname, "r");
+
+    if (f == NULL) {
+        return false;
+    }
+
+    uint8_t regionOf[81];
+    size_t index = 0;
+    int c;
+
+    while ((c = fgetc(f)) != EOF) {
+        if (c == '#') {
+            do {
+                c = fgetc(f);
+            } while (c != '\n' && c != EOF);
+        }
+        else if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            continue;
+        }
+        else if (index == 81) {
+            index = 82;
+            break;
+        }
+        else if ('1' <= c && c <= '9') {
+            regionOf[index++] = static_cast<uint8_t>(c - '1');
+        }
+        else if ('a' <= c && c <= 'i') {
+            regionOf[index++] = static_cast<uint8_t>(c - 'a');
+        }
+        else {
+            index = 82;
+            break;
+        }
+    }
+
+    fclose(f);
+
+    return index == 81 && makeJigsawTable(regionOf, table);
+}
@@ -0,0 +1,258 @@
+#include <array>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SUSOLV_VERIFY_SSE2
+#endif
+
+#include "susolv/batch.h"
+#include "susolv/cellIndexLookup.h"
+#include "susolv/verify.h"
+
+namespace {
+
+constexpr int UNITS = 27;     // rows, then cols, then quads
+constexpr int UNIT_LANES = 32; // units padded out to a ymm (or two xmm) per row of the matrix
+constexpr int PADDED_CELLS = 96; // 81 cells padded out to 6 xmm
+
+/**
+ * the grid regathered unit-major: matrix[i][u] is the i-th cell of unit u, so lane u of the OR over i of
+ * (matrix[i] == digit) says whether unit u has `digit` somewhere.
+ */
+constexpr std::array<std::array<uint8_t, UNITS>, 9> makeUnitCells() {
+    std::array<std::array<uint8_t, UNITS>, 9> cells{};
+    for (int i = 0; i < 9; ++i) {
+        for (int unit = 0; unit < 9; ++unit) {
+            cells[i][unit] = cellIndexLookup.rowElementIndices[unit][i];
+            cells[i][9 + unit] = cellIndexLookup.colElementIndices[unit][i];
+            cells[i][18 + unit] = cellIndexLookup.quadElementIndices[unit][i];
+        }
+    }
+    return cells;
+}
+
+constexpr auto UNIT_CELLS = makeUnitCells();
+
+constexpr bool isDigit(char c) {
+    return c >= '1' && c <= '9';
+}
+
+#if defined(__AVX2__) || defined(SUSOLV_VERIFY_SSE2)
+
+// 96 bytes each, the tail past 81 filled with a matching clue/value pair so it never trips anything
+struct alignas(32) PaddedPair {
+    char puzzle[PADDED_CELLS];
+    char grid[PADDED_CELLS];
+
+    PaddedPair(const char* p, const char* g) {
+        std::memcpy(puzzle, p, BOARD_CELLS);
+        std::memcpy(grid, g, BOARD_CELLS);
+        std::memset(puzzle + BOARD_CELLS, '1', PADDED_CELLS - BOARD_CELLS);
+        std::memset(grid + BOARD_CELLS, '1', PADDED_CELLS - BOARD_CELLS);
+    }
+};
+
+struct alignas(32) UnitMatrix {
+    char lanes[9][UNIT_LANES];
+
+    explicit UnitMatrix(const char* grid) {
+        for (int i = 0; i < 9; ++i) {
+            for (int unit = 0; unit < UNITS; ++unit) {
+                lanes[i][unit] = grid[UNIT_CELLS[i][unit]];
+            }
+            std::memset(lanes[i] + UNITS, 0, UNIT_LANES - UNITS);
+        }
+    }
+};
+
+constexpr uint32_t ALL_UNITS_MASK = (1u << UNITS) - 1;
+
+#endif
+
+#if defined(__AVX2__)
+
+VerifyStatus verifyVector(const char* puzzleCells, const char* gridCells) {
+    const PaddedPair pair(puzzleCells, gridCells);
+
+    // per cell checks, 32 at a time. bytes are compared unsigned by biasing to signed range first
+    const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80));
+    const __m256i below1 = _mm256_set1_epi8(static_cast<char>(('1' - 1) ^ 0x80));
+    const __m256i above9 = _mm256_set1_epi8(static_cast<char>(('9' + 1) ^ 0x80));
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i dot = _mm256_set1_epi8('.');
+
+    __m256i malformed = _mm256_setzero_si256();
+    __m256i mismatch = _mm256_setzero_si256();
+
+    for (int offset = 0; offset < PADDED_CELLS; offset += 32) {
+        const __m256i p = _mm256_load_si256(reinterpret_cast<const __m256i*>(pair.puzzle + offset));
+        const __m256i g = _mm256_load_si256(reinterpret_cast<const __m256i*>(pair.grid + offset));
+        const __m256i pb = _mm256_xor_si256(p, bias);
+        const __m256i gb = _mm256_xor_si256(g, bias);
+
+        const __m256i clue = _mm256_and_si256(_mm256_cmpgt_epi8(pb, below1), _mm256_cmpgt_epi8(above9, pb));
+        const __m256i gridDigit = _mm256_and_si256(_mm256_cmpgt_epi8(gb, below1), _mm256_cmpgt_epi8(above9, gb));
+        const __m256i blank = _mm256_or_si256(_mm256_cmpeq_epi8(p, zero), _mm256_cmpeq_epi8(p, dot));
+
+        malformed = _mm256_or_si256(malformed, _mm256_andnot_si256(gridDigit, _mm256_set1_epi8(-1)));
+        malformed = _mm256_or_si256(malformed, _mm256_andnot_si256(_mm256_or_si256(clue, blank), _mm256_set1_epi8(-1)));
+        mismatch = _mm256_or_si256(mismatch, _mm256_andnot_si256(_mm256_cmpeq_epi8(p, g), clue));
+    }
+
+    if (_mm256_movemask_epi8(malformed)) {
+        return VerifyStatus::malformed;
+    }
+    if (_mm256_movemask_epi8(mismatch)) {
+        return VerifyStatus::clueMismatch;
+    }
+
+    const UnitMatrix matrix(pair.grid);
+    __m256i rows[9];
+    for (int i = 0; i < 9; ++i) {
+        rows[i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(matrix.lanes[i]));
+    }
+
+    __m256i everyDigit = _mm256_set1_epi8(-1);
+    for (char digit = '1'; digit <= '9'; ++digit) {
+        const __m256i d = _mm256_set1_epi8(digit);
+        __m256i seen = _mm256_cmpeq_epi8(rows[0], d);
+        for (int i = 1; i < 9; ++i) {
+            seen = _mm256_or_si256(seen, _mm256_cmpeq_epi8(rows[i], d));
+        }
+        everyDigit = _mm256_and_si256(everyDigit, seen);
+    }
+
+    // 9 cells holding all 9 digits means each exactly once
+    const uint32_t units = static_cast<uint32_t>(_mm256_movemask_epi8(everyDigit));
+    return (units & ALL_UNITS_MASK) == ALL_UNITS_MASK ? VerifyStatus::valid : VerifyStatus::unitViolation;
+}
+
+#elif defined(SUSOLV_VERIFY_SSE2)
+
+VerifyStatus verifyVector(const char* puzzleCells, const char* gridCells) {
+    const PaddedPair pair(puzzleCells, gridCells);
+
+    // per cell checks, 16 at a time. bytes are compared unsigned by biasing to signed range first
+    const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+    const __m128i below1 = _mm_set1_epi8(static_cast<char>(('1' - 1) ^ 0x80));
+    const __m128i above9 = _mm_set1_epi8(static_cast<char>(('9' + 1) ^ 0x80));
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i dot = _mm_set1_epi8('.');
+    const __m128i ones = _mm_set1_epi8(-1);
+
+    __m128i malformed = _mm_setzero_si128();
+    __m128i mismatch = _mm_setzero_si128();
+
+    for (int offset = 0; offset < PADDED_CELLS; offset += 16) {
+        const __m128i p = _mm_load_si128(reinterpret_cast<const __m128i*>(pair.puzzle + offset));
+        const __m128i g = _mm_load_si128(reinterpret_cast<const __m128i*>(pair.grid + offset));
+        const __m128i pb = _mm_xor_si128(p, bias);
+        const __m128i gb = _mm_xor_si128(g, bias);
+
+        const __m128i clue = _mm_and_si128(_mm_cmpgt_epi8(pb, below1), _mm_cmplt_epi8(pb, above9));
+        const __m128i gridDigit = _mm_and_si128(_mm_cmpgt_epi8(gb, below1), _mm_cmplt_epi8(gb, above9));
+        const __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(p, zero), _mm_cmpeq_epi8(p, dot));
+
+        malformed = _mm_or_si128(malformed, _mm_andnot_si128(gridDigit, ones));
+        malformed = _mm_or_si128(malformed, _mm_andnot_si128(_mm_or_si128(clue, blank), ones));
+        mismatch = _mm_or_si128(mismatch, _mm_andnot_si128(_mm_cmpeq_epi8(p, g), clue));
+    }
+
+    if (_mm_movemask_epi8(malformed)) {
+        return VerifyStatus::malformed;
+    }
+    if (_mm_movemask_epi8(mismatch)) {
+        return VerifyStatus::clueMismatch;
+    }
+
+    const UnitMatrix matrix(pair.grid);
+    __m128i lo[9];
+    __m128i hi[9];
+    for (int i = 0; i < 9; ++i) {
+        lo[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(matrix.lanes[i]));
+        hi[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(matrix.lanes[i] + 16));
+    }
+
+    __m128i everyDigitLo = ones;
+    __m128i everyDigitHi = ones;
+    for (char digit = '1'; digit <= '9'; ++digit) {
+        const __m128i d = _mm_set1_epi8(digit);
+        __m128i seenLo = _mm_cmpeq_epi8(lo[0], d);
+        __m128i seenHi = _mm_cmpeq_epi8(hi[0], d);
+        for (int i = 1; i < 9; ++i) {
+            seenLo = _mm_or_si128(seenLo, _mm_cmpeq_epi8(lo[i], d));
+            seenHi = _mm_or_si128(seenHi, _mm_cmpeq_epi8(hi[i], d));
+        }
+        everyDigitLo = _mm_and_si128(everyDigitLo, seenLo);
+        everyDigitHi = _mm_and_si128(everyDigitHi, seenHi);
+    }
+
+    // 9 cells holding all 9 digits means each exactly once
+    const uint32_t units = static_cast<uint32_t>(_mm_movemask_epi8(everyDigitLo))
+        | static_cast<uint32_t>(_mm_movemask_epi8(everyDigitHi)) << 16;
+    return (units & ALL_UNITS_MASK) == ALL_UNITS_MASK ? VerifyStatus::valid : VerifyStatus::unitViolation;
+}
+
+#endif
+
+} // namespace
+
+VerifyStatus verifySolutionScalar(const char* puzzle, const char* grid) {
+    for (size_t i = 0; i < BOARD_CELLS; ++i) {
+        const char p = puzzle[i];
+        if (!isDigit(grid[i]) || !(isDigit(p) || p == '0' || p == '.')) {
+            return VerifyStatus::malformed;
+        }
+    }
+
+    for (size_t i = 0; i < BOARD_CELLS; ++i) {
+        if (isDigit(puzzle[i]) && puzzle[i] != grid[i]) {
+            return VerifyStatus::clueMismatch;
+        }
+    }
+
+    for (int unit = 0; unit < UNITS; ++unit) {
+        uint16_t seen = 0;
+        for (int i = 0; i < 9; ++i) {
+            seen |= 1 << (grid[UNIT_CELLS[i][unit]] - '1');
+        }
+        if (seen != 0x1FF) {
+            return VerifyStatus::unitViolation;
+        }
+    }
+
+    return VerifyStatus::valid;
+}
+
+VerifyStatus verifySolution(const char* puzzle, const char* grid) {
+#if defined(__AVX2__) || defined(SUSOLV_VERIFY_SSE2)
+    return verifyVector(puzzle, grid);
+#else
+    return verifySolutionScalar(puzzle, grid);
+#endif
+}
+
+VerifyStatus verifySolution(const Board& puzzle, const Board& solved) {
+    char clues[BOARD_CELLS];
+    char grid[BOARD_CELLS];
+    writeBoard(puzzle, clues);
+    writeBoard(solved, grid);
+    return verifySolution(clues, grid);
+}
+
+size_t verifyBatch(const char* puzzles, const char* grids, VerifyStatus* statuses, size_t count) {
+    size_t validCount = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const VerifyStatus status = verifySolution(puzzles + i * BOARD_CELLS, grids + i * BOARD_CELLS);
+        validCount += status == VerifyStatus::valid;
+        if (statuses) {
+            statuses[i] = status;
+        }
+    }
+
+    return validCount;
+}
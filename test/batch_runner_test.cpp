@@ -0,0 +1,272 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <chrono>
+#include <csignal>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#endif
+
+#include <gtest/gtest.h>
+#include "susolv/batch.h"
+#include "susolv/batchRunner.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string readFile(const fs::path& path) {
+    std::ifstream f(path, std::ios::binary);
+    std::stringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+// scratch directory per test, removed on the way out
+struct ScratchDir {
+    fs::path path;
+
+    explicit ScratchDir(const char* name)
+        : path(fs::temp_directory_path() / (std::string("susolv_batch_runner_") + name)) {
+        fs::remove_all(path);
+        fs::create_directories(path);
+    }
+    ~ScratchDir() {
+        std::error_code error;
+        fs::remove_all(path, error);
+    }
+};
+
+BatchRunOptions optionsFor(const ScratchDir& dir, const std::string& input) {
+    BatchRunOptions options;
+    options.inputPath = input;
+    options.outputPath = (dir.path / "out.txt").string();
+    options.checkpointPath = (dir.path / "out.ckpt").string();
+    options.solve.engine = SolveEngine::bitboard;
+    return options;
+}
+
+} // namespace
+
+TEST(BatchRunnerSuite, WritesOneLinePerPuzzleInOrder) {
+    ScratchDir dir("order");
+    const fs::path input = dir.path / "in.txt";
+    {
+        std::ofstream f(input, std::ios::binary);
+        f << "# comment\n"
+          << "003020600900305001001806400008102900700000008006708200002609500800203009005010300\n"
+          << "\n"
+          << "not a puzzle\n"
+          << "203020600900305001001806400008102900700000008006708200002609500800203009005010300"; // no trailing newline
+    }
+
+    BatchRunOptions options = optionsFor(dir, input.string());
+    BatchRunStats stats;
+    ASSERT_TRUE(runBatch(options, stats));
+
+    EXPECT_EQ(stats.completed, 3);
+    EXPECT_EQ(stats.solved, 1);
+    EXPECT_EQ(stats.invalid, 2);
+    EXPECT_EQ(stats.inputOffset, fs::file_size(input));
+    EXPECT_FALSE(fs::exists(options.checkpointPath));
+
+    const std::string zeros(BOARD_CELLS, '0');
+    EXPECT_EQ(readFile(options.outputPath),
+        "483921657967345821251876493548132976729564138136798245372689514814253769695417382\n" + zeros + "\n" + zeros + "\n");
+}
+
+TEST(BatchRunnerSuite, WorkersKeepInvalidLinesInPlace) {
+    ScratchDir dir("workers_invalid");
+    const fs::path input = dir.path / "in.txt";
+    {
+        std::ofstream f(input, std::ios::binary);
+        f << "# comment\n"
+          << "003020600900305001001806400008102900700000008006708200002609500800203009005010300\n"
+          << "\n"
+          << "not a puzzle\n"
+          << "203020600900305001001806400008102900700000008006708200002609500800203009005010300"; // no trailing newline
+    }
+
+    BatchRunOptions options = optionsFor(dir, input.string());
+    options.workers = 3;
+    BatchRunStats stats;
+    ASSERT_TRUE(runBatch(options, stats));
+
+    EXPECT_EQ(stats.completed, 3);
+    EXPECT_EQ(stats.solved, 1);
+    EXPECT_EQ(stats.invalid, 2);
+    EXPECT_EQ(stats.inputOffset, fs::file_size(input));
+    EXPECT_FALSE(fs::exists(options.checkpointPath));
+
+    const std::string zeros(BOARD_CELLS, '0');
+    EXPECT_EQ(readFile(options.outputPath),
+        "483921657967345821251876493548132976729564138136798245372689514814253769695417382\n" + zeros + "\n" + zeros + "\n");
+}
+
+TEST(BatchRunnerSuite, ZeroIntervalNeverCheckpoints) {
+    ScratchDir dir("every_zero");
+
+    BatchRunOptions options = optionsFor(dir, SUSOLV_BOARDS_DIR "hard.txt");
+    options.checkpointEvery = 0;
+    options.workers = 2;
+    options.stopAfter = 20;
+    BatchRunStats stats;
+    ASSERT_TRUE(runBatch(options, stats));
+    EXPECT_EQ(stats.completed, 20);
+    EXPECT_FALSE(fs::exists(options.checkpointPath));
+}
+
+TEST(BatchRunnerSuite, ResumedRunMatchesUninterruptedRun) {
+    ScratchDir dir("resume");
+    const std::string input = SUSOLV_BOARDS_DIR "hard.txt";
+
+    BatchRunOptions reference = optionsFor(dir, input);
+    reference.outputPath = (dir.path / "reference.txt").string();
+    reference.checkpointPath.clear();
+    BatchRunStats referenceStats;
+    ASSERT_TRUE(runBatch(reference, referenceStats));
+
+    // stop mid way between checkpoints: 37 done, last checkpoint at 30, 7 lines of output to throw away
+    BatchRunOptions options = optionsFor(dir, input);
+    options.checkpointEvery = 10;
+    options.stopAfter = 37;
+    BatchRunStats stats;
+    ASSERT_TRUE(runBatch(options, stats));
+    EXPECT_EQ(stats.completed, 37);
+    EXPECT_EQ(fs::file_size(options.outputPath), 37 * (BOARD_CELLS + 1));
+
+    BatchRunStats checkpointed;
+    ASSERT_TRUE(readCheckpoint(options.checkpointPath, checkpointed));
+    EXPECT_EQ(checkpointed.completed, 30);
+
+    options.stopAfter = UINT64_MAX;
+    ASSERT_TRUE(runBatch(options, stats));
+    EXPECT_TRUE(stats.resumed);
+    EXPECT_EQ(stats.completed, referenceStats.completed);
+    EXPECT_EQ(stats.solved, referenceStats.solved);
+    EXPECT_EQ(stats.nodes, referenceStats.nodes);
+    EXPECT_EQ(readFile(options.outputPath), readFile(reference.outputPath));
+}
+
+TEST(BatchRunnerSuite, RefusesCheckpointForAnotherInput) {
+    ScratchDir dir("other_input");
+    const fs::path other = dir.path / "other.txt";
+    fs::copy_file(SUSOLV_BOARDS_DIR "hard.txt", other);
+
+    BatchRunOptions options = optionsFor(dir, SUSOLV_BOARDS_DIR "hard.txt");
+    options.checkpointEvery = 10;
+    options.stopAfter = 15;
+    BatchRunStats stats;
+    ASSERT_TRUE(runBatch(options, stats));
+
+    // same contents, different file
+    options.inputPath = other.string();
+    options.stopAfter = UINT64_MAX;
+    EXPECT_FALSE(runBatch(options, stats));
+    EXPECT_EQ(fs::file_size(options.outputPath), 15 * (BOARD_CELLS + 1));
+
+    // same file, grown since
+    options.inputPath = SUSOLV_BOARDS_DIR "hard.txt";
+    BatchRunStats checkpointed;
+    ASSERT_TRUE(readCheckpoint(options.checkpointPath, checkpointed));
+    checkpointed.inputSize += 1;
+    ASSERT_TRUE(writeCheckpoint(options.checkpointPath, checkpointed, false));
+    EXPECT_FALSE(runBatch(options, stats));
+}
+
+TEST(BatchRunnerSuite, FailsWhenCheckpointCantBeWritten) {
+    ScratchDir dir("unwritable");
+
+    BatchRunOptions options = optionsFor(dir, SUSOLV_BOARDS_DIR "hard.txt");
+    options.checkpointPath = (dir.path / "missing" / "out.ckpt").string();
+    options.checkpointEvery = 10;
+    BatchRunStats stats;
+    EXPECT_FALSE(runBatch(options, stats));
+    EXPECT_EQ(stats.completed, 10);
+}
+
+TEST(BatchRunnerSuite, WorkersMatchSerialRun) {
+    ScratchDir dir("workers");
+    const std::string input = SUSOLV_BOARDS_DIR "hard.txt";
+
+    BatchRunOptions reference = optionsFor(dir, input);
+    reference.outputPath = (dir.path / "reference.txt").string();
+    reference.checkpointPath.clear();
+    BatchRunStats referenceStats;
+    ASSERT_TRUE(runBatch(reference, referenceStats));
+
+    // checkpoints cut the chunks short, and the stop lands inside one
+    BatchRunOptions options = optionsFor(dir, input);
+    options.workers = 3;
+    options.checkpointEvery = 25;
+    options.stopAfter = 60;
+    BatchRunStats stats;
+    ASSERT_TRUE(runBatch(options, stats));
+    EXPECT_EQ(stats.completed, 60);
+
+    BatchRunStats checkpointed;
+    ASSERT_TRUE(readCheckpoint(options.checkpointPath, checkpointed));
+    EXPECT_EQ(checkpointed.completed, 50);
+
+    options.stopAfter = UINT64_MAX;
+    ASSERT_TRUE(runBatch(options, stats));
+    EXPECT_EQ(stats.completed, referenceStats.completed);
+    EXPECT_EQ(stats.solved, referenceStats.solved);
+    EXPECT_EQ(stats.nodes, referenceStats.nodes);
+    EXPECT_EQ(readFile(options.outputPath), readFile(reference.outputPath));
+}
+
+#ifdef __linux__
+TEST(BatchRunnerSuite, SurvivesSigkill) {
+    ScratchDir dir("kill");
+
+    // enough work that the child is still going when it's killed
+    const fs::path input = dir.path / "in.txt";
+    {
+        const std::string hard = readFile(SUSOLV_BOARDS_DIR "hard.txt");
+        std::ofstream f(input, std::ios::binary);
+        for (int i = 0; i < 5; ++i) {
+            f << hard;
+        }
+    }
+
+    BatchRunOptions reference = optionsFor(dir, input.string());
+    reference.outputPath = (dir.path / "reference.txt").string();
+    reference.checkpointPath.clear();
+    BatchRunStats referenceStats;
+    ASSERT_TRUE(runBatch(reference, referenceStats));
+
+    BatchRunOptions options = optionsFor(dir, input.string());
+    options.checkpointEvery = 7;
+
+    const pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        BatchRunStats stats;
+        _exit(runBatch(options, stats) ? 0 : 1);
+    }
+
+    // kill it a few checkpoints in
+    const auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    BatchRunStats checkpointed;
+    while (std::chrono::steady_clock::now() < giveUp
+        && !(readCheckpoint(options.checkpointPath, checkpointed) && checkpointed.completed >= 3 * options.checkpointEvery)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    kill(child, SIGKILL);
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFSIGNALED(status)) << "child finished before it could be killed";
+
+    BatchRunStats stats;
+    ASSERT_TRUE(runBatch(options, stats));
+    EXPECT_TRUE(stats.resumed);
+    EXPECT_EQ(stats.completed, referenceStats.completed);
+    EXPECT_EQ(stats.nodes, referenceStats.nodes);
+    EXPECT_EQ(readFile(options.outputPath), readFile(reference.outputPath));
+}
+#endif
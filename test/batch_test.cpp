@@ -0,0 +1,65 @@
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "susolv/batch.h"
+#include "susolv/susolv.h"
+
+// euler96 grid 01 and its solution
+static const char* PUZZLE   = "003020600900305001001806400008102900700000008006708200002609500800203009005010300";
+static const char* SOLUTION = "483921657967345821251876493548132976729564138136798245372689514814253769695417382";
+
+TEST(BatchSuite, SolvesPackedBuffers) {
+    std::string puzzles = std::string(PUZZLE) + PUZZLE + PUZZLE;
+    std::string solutions(puzzles.size(), 'x');
+    BatchStatus statuses[3];
+
+    EXPECT_EQ(solveBatch(puzzles.data(), solutions.data(), statuses, 3), 3);
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(statuses[i], BatchStatus::solved);
+        EXPECT_EQ(solutions.substr(i * BOARD_CELLS, BOARD_CELLS), SOLUTION);
+    }
+}
+
+TEST(BatchSuite, ReportsBadPuzzlesPerSlot) {
+    std::string duplicateClue = PUZZLE;
+    duplicateClue[0] = '2'; // row 0 already has a 2
+    std::string badByte = PUZZLE;
+    badByte[40] = 'x';
+    std::string dotted = PUZZLE;
+    for (char& c : dotted) {
+        if (c == '0') c = '.';
+    }
+
+    std::string puzzles = duplicateClue + badByte + dotted;
+    std::string solutions(puzzles.size(), 'x');
+    BatchStatus statuses[3];
+
+    EXPECT_EQ(solveBatch(puzzles.data(), solutions.data(), statuses, 3), 1);
+    EXPECT_EQ(statuses[0], BatchStatus::invalidInput);
+    EXPECT_EQ(statuses[1], BatchStatus::invalidInput);
+    EXPECT_EQ(statuses[2], BatchStatus::solved);
+    EXPECT_EQ(solutions.substr(0, BOARD_CELLS), std::string(BOARD_CELLS, '0'));
+    EXPECT_EQ(solutions.substr(2 * BOARD_CELLS, BOARD_CELLS), SOLUTION);
+}
+
+TEST(BatchSuite, UnsolvableIsNotInvalid) {
+    // clues are consistent, but cell 0 has no candidates left
+    std::string puzzle(BOARD_CELLS, '0');
+    std::memcpy(puzzle.data() + 1, "12345678", 8);
+    puzzle[9] = '9';
+
+    char solution[BOARD_CELLS];
+    EXPECT_EQ(susolv_solve(puzzle.data(), solution), SUSOLV_UNSOLVABLE);
+}
+
+TEST(BatchSuite, CApiMatchesCpp) {
+    char solution[BOARD_CELLS];
+    EXPECT_EQ(susolv_solve(PUZZLE, solution), SUSOLV_SOLVED);
+    EXPECT_EQ(std::string(solution, BOARD_CELLS), SOLUTION);
+
+    uint8_t status = 0xFF;
+    EXPECT_EQ(susolv_solve_batch(PUZZLE, solution, &status, 1), 1);
+    EXPECT_EQ(status, SUSOLV_SOLVED);
+}
@@ -0,0 +1,105 @@
+#include <map>
+
+#include <gtest/gtest.h>
+#include "susolv/batch.h"
+#include "susolv/bitBoard.h"
+#include "susolv/euler96.h"
+#include "susolv/verify.h"
+
+static SolveOptions bitboardOptions() {
+    SolveOptions options;
+    options.engine = SolveEngine::bitboard;
+    return options;
+}
+
+// MainSuite.ItSolvesABoardCorrectly, through the bitboard engine
+TEST(BitBoardSuite, ItSolvesABoardCorrectly) {
+    Board board = loadBoard(SUSOLV_BOARDS_DIR "euler96-29.txt");
+    SolveResult result = solve(board, bitboardOptions());
+
+    ASSERT_EQ(result.status, SolveStatus::solved);
+
+    std::map<int, int> solvedValues = {};
+    for (int i = 0; i < 81; ++i) {
+        int solvedValue = result.board.getSolvedValue(i);
+        EXPECT_EQ(1 <= solvedValue && solvedValue <= 9, true);
+        solvedValues[solvedValue] += 1;
+    }
+
+    ASSERT_EQ(solvedValues.size(), 9);
+    for (int i = 1; i <= 9; ++i) {
+        EXPECT_EQ(solvedValues.at(i), 9);
+    }
+}
+
+TEST(BitBoardSuite, MatchesCellMajorOnEuler96) {
+    for (const Board& board : loadEuler96(SUSOLV_BOARDS_DIR "euler96-all.txt")) {
+        std::optional<Board> expected = solve(board);
+        SolveResult result = solve(board, bitboardOptions());
+
+        ASSERT_EQ(expected.has_value(), true);
+        ASSERT_EQ(result.status, SolveStatus::solved);
+        for (uint8_t i = 0; i < 81; ++i) {
+            EXPECT_EQ(result.board.getSolvedValue(i), expected->getSolvedValue(i));
+        }
+    }
+}
+
+TEST(BitBoardSuite, SolvesHardAndSeventeenClueSets) {
+    for (const char* set : { SUSOLV_BOARDS_DIR "hard.txt", SUSOLV_BOARDS_DIR "17clue.txt" }) {
+        for (const Board& board : loadPackedBoards(set)) {
+            SolveResult result = solve(board, bitboardOptions());
+            ASSERT_EQ(result.status, SolveStatus::solved);
+            char clues[BOARD_CELLS];
+            char cells[BOARD_CELLS];
+            writeBoard(board, clues);
+            writeBoard(result.board, cells);
+            EXPECT_EQ(verifySolution(clues, cells), VerifyStatus::valid);
+        }
+    }
+}
+
+TEST(BitBoardSuite, LimitsAndUnsolvable) {
+    Board hard;
+    ASSERT_EQ(parseBoard("1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..", hard), true);
+
+    SolveOptions budget = bitboardOptions();
+    budget.nodeBudget = 3;
+    SolveResult timedOut = solve(hard, budget);
+    EXPECT_EQ(timedOut.status, SolveStatus::timedOut);
+    EXPECT_EQ(timedOut.stats.nodes, 3);
+
+    std::stop_source source;
+    source.request_stop();
+    SolveOptions cancel = bitboardOptions();
+    cancel.stopToken = source.get_token();
+    EXPECT_EQ(solve(hard, cancel).status, SolveStatus::cancelled);
+
+    const uint8_t input[9][9] = {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8},
+        {9, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+    };
+    SolveResult unsolvable = solve(Board(input), bitboardOptions());
+    EXPECT_EQ(unsolvable.status, SolveStatus::unsolvable);
+    EXPECT_EQ(unsolvable.stats.nodes, 1);
+}
+
+TEST(BitBoardSuite, ClashingCluesAreUnsolvable) {
+    Board board = Board::ZeroedBoard();
+    for (uint8_t i = 0; i < 81; ++i) {
+        board.setUnknown(i);
+    }
+    board.setSolved(0, 4);
+    board.setSolved(8, 4);
+
+    BitBoard bits;
+    EXPECT_EQ(bits.load(board), false);
+    EXPECT_EQ(solve(board, bitboardOptions()).status, SolveStatus::unsolvable);
+}
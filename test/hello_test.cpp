@@ -153,8 +153,7 @@ TEST(MainSuite, IteratorSmokeTest_NoSolutions) {
 }
 
 TEST(MainSuite, ItSolvesABoardCorrectly) {
-    // fixme: get this path somehow from cmake ... ?
-    Board board = loadBoard("c:\\users\\anon\\dev\\susolv\\boards\\euler96-29.txt");
+    Board board = loadBoard(SUSOLV_BOARDS_DIR "euler96-29.txt");
     std::optional<Board> maybeSolvedBoard = solve(board);
 
     EXPECT_EQ(maybeSolvedBoard.has_value(), true);
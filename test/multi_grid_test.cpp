@@ -0,0 +1,187 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "susolv/batch.h"
+#include "susolv/multiGrid.h"
+#include "susolv/verify.h"
+
+static std::vector<std::string> emptyCanvas() {
+    std::vector<std::string> rows(SAMURAI_LAYOUT.height, std::string(SAMURAI_LAYOUT.width, ' '));
+    for (size_t grid = 0; grid < 5; ++grid) {
+        for (uint8_t cell = 0; cell < 81; ++cell) {
+            rows[SAMURAI_LAYOUT.canvasRow(grid, cell)][SAMURAI_LAYOUT.canvasCol(grid, cell)] = '.';
+        }
+    }
+    return rows;
+}
+
+// every grid a valid sudoku keeping its clues, and both copies of each overlap cell equal
+static void expectSolves(const SamuraiBoard& puzzle, const SamuraiBoard& solved) {
+    for (size_t grid = 0; grid < 5; ++grid) {
+        char clues[BOARD_CELLS];
+        char cells[BOARD_CELLS];
+        writeBoard(puzzle.grids[grid], clues);
+        writeBoard(solved.grids[grid], cells);
+        EXPECT_EQ(verifySolution(clues, cells), VerifyStatus::valid) << "grid " << grid;
+
+        for (uint8_t cell = 0; cell < 81; ++cell) {
+            const auto twin = SAMURAI_LAYOUT.twins[grid][cell];
+            if (twin.grid != SamuraiBoard::Layout::NO_TWIN) {
+                EXPECT_EQ(solved.getSolvedValue(grid, cell), solved.getSolvedValue(twin.grid, twin.cell));
+            }
+        }
+    }
+}
+
+TEST(MultiGridSuite, SamuraiLayoutSharesCornerQuads) {
+    EXPECT_EQ(SAMURAI_LAYOUT.height, 21);
+    EXPECT_EQ(SAMURAI_LAYOUT.width, 21);
+
+    // top left cell of each shared quad, outer grid side -> center grid side
+    const uint8_t links[4][3] = { {0, 60, 0}, {1, 54, 6}, {3, 6, 54}, {4, 0, 60} };
+    for (const auto& [grid, cell, centerCell] : links) {
+        EXPECT_EQ(SAMURAI_LAYOUT.twins[grid][cell].grid, 2);
+        EXPECT_EQ(SAMURAI_LAYOUT.twins[grid][cell].cell, centerCell);
+        EXPECT_EQ(SAMURAI_LAYOUT.twins[2][centerCell].grid, grid);
+        EXPECT_EQ(SAMURAI_LAYOUT.twins[2][centerCell].cell, cell);
+    }
+
+    size_t shared[5] = {};
+    for (size_t grid = 0; grid < 5; ++grid) {
+        for (uint8_t cell = 0; cell < 81; ++cell) {
+            shared[grid] += SAMURAI_LAYOUT.twins[grid][cell].grid != SamuraiBoard::Layout::NO_TWIN;
+        }
+    }
+    EXPECT_EQ(shared[0], 9);
+    EXPECT_EQ(shared[1], 9);
+    EXPECT_EQ(shared[2], 36);
+    EXPECT_EQ(shared[3], 9);
+    EXPECT_EQ(shared[4], 9);
+}
+
+TEST(MultiGridSuite, PropagationCrossesOverlaps) {
+    SamuraiBoard board(SAMURAI_LAYOUT);
+
+    // grid 0's row 6 rules out 1-6 for its cell 60, the center grid's col 0 rules out 7 and 8 for the
+    // same cell (its cell 0). neither grid alone pins it down; together it can only be 9
+    for (uint8_t i = 0; i < 6; ++i) {
+        board.setSolved(0, 54 + i, i);
+    }
+    board.setSolved(2, 27, 6);
+    board.setSolved(2, 36, 7);
+
+    EXPECT_EQ(std::popcount(board.grids[0].availableValuesForCell(60)), 3);
+    EXPECT_EQ(std::popcount(board.grids[2].availableValuesForCell(0)), 7);
+    EXPECT_EQ(board.availableValues(0, 60), 1 << 8);
+
+    const auto result = board.propagate();
+    EXPECT_FALSE(result.invalid);
+    ASSERT_TRUE(board.isSolved(0, 60));
+    ASSERT_TRUE(board.isSolved(2, 0));
+    EXPECT_EQ(board.getSolvedValue(0, 60), 9);
+    EXPECT_EQ(board.getSolvedValue(2, 0), 9);
+}
+
+TEST(MultiGridSuite, ParseRejectsBadInput) {
+    SamuraiBoard board(SAMURAI_LAYOUT);
+    std::vector<std::string> rows = emptyCanvas();
+    EXPECT_TRUE(parseSamurai(rows, board));
+
+    // canvas (6, 7) is in grids 0 and 2, canvas (6, 10) only in grid 2 but in the same grid 2 row
+    rows[6][7] = '5';
+    rows[6][10] = '5';
+    EXPECT_FALSE(parseSamurai(rows, board));
+
+    rows = emptyCanvas();
+    rows[0][10] = '1'; // the gap between grids 0 and 1
+    EXPECT_FALSE(parseSamurai(rows, board));
+
+    rows = emptyCanvas();
+    rows[20][20] = 'x';
+    EXPECT_FALSE(parseSamurai(rows, board));
+
+    rows = emptyCanvas();
+    rows.pop_back();
+    EXPECT_FALSE(parseSamurai(rows, board));
+}
+
+TEST(MultiGridSuite, SolvesTheSamuraiSet) {
+    const std::vector<SamuraiBoard> boards = loadSamuraiBoards(SUSOLV_BOARDS_DIR "samurai.txt");
+    ASSERT_EQ(boards.size(), 40);
+
+    std::vector<SamuraiBoard> stack;
+    SamuraiBoard solved(SAMURAI_LAYOUT);
+    for (size_t i = 0; i < 10; ++i) {
+        SolveStats stats;
+        ASSERT_EQ(solveInto(boards[i], solved, stack, MultiGridOptions{}, stats), SolveStatus::solved) << i;
+        expectSolves(boards[i], solved);
+    }
+}
+
+TEST(MultiGridSuite, ParallelPropagationMatchesSerial) {
+    const std::vector<SamuraiBoard> boards = loadSamuraiBoards(SUSOLV_BOARDS_DIR "samurai.txt");
+    GridWorkers workers(3);
+    MultiGridOptions parallel;
+    parallel.workers = &workers;
+
+    std::vector<SamuraiBoard> stack;
+    SamuraiBoard serialSolved(SAMURAI_LAYOUT);
+    SamuraiBoard parallelSolved(SAMURAI_LAYOUT);
+    for (size_t i = 0; i < 5; ++i) {
+        SolveStats serialStats;
+        SolveStats parallelStats;
+        ASSERT_EQ(solveInto(boards[i], serialSolved, stack, MultiGridOptions{}, serialStats), SolveStatus::solved);
+        ASSERT_EQ(solveInto(boards[i], parallelSolved, stack, parallel, parallelStats), SolveStatus::solved);
+        EXPECT_EQ(serialStats.nodes, parallelStats.nodes);
+
+        std::ostringstream a, b;
+        writeSamurai(serialSolved, a);
+        writeSamurai(parallelSolved, b);
+        EXPECT_EQ(a.str(), b.str());
+    }
+}
+
+TEST(MultiGridSuite, WriteParseRoundTrip) {
+    const SamuraiBoard board = loadSamuraiBoards(SUSOLV_BOARDS_DIR "samurai.txt").front();
+    std::ostringstream out;
+    writeSamurai(board, out);
+
+    std::vector<std::string> rows;
+    std::istringstream in(out.str());
+    for (std::string line; std::getline(in, line);) {
+        rows.push_back(line);
+    }
+
+    SamuraiBoard parsed(SAMURAI_LAYOUT);
+    ASSERT_TRUE(parseSamurai(rows, parsed));
+    std::ostringstream again;
+    writeSamurai(parsed, again);
+    EXPECT_EQ(again.str(), out.str());
+}
+
+TEST(MultiGridSuite, LimitsAndUnsolvable) {
+    std::vector<SamuraiBoard> stack;
+    SamuraiBoard solved(SAMURAI_LAYOUT);
+
+    MultiGridOptions options;
+    options.limits.nodeBudget = 5;
+    SolveStats stats;
+    EXPECT_EQ(solveInto(SamuraiBoard(SAMURAI_LAYOUT), solved, stack, options, stats), SolveStatus::timedOut);
+    EXPECT_EQ(stats.nodes, 5);
+
+    // grid 1's cell 54 (its bottom left quad, shared with the center) has every value ruled out between the two grids
+    SamuraiBoard board(SAMURAI_LAYOUT);
+    for (uint8_t i = 0; i < 6; ++i) {
+        board.setSolved(1, 55 + i, i); // grid 1 row 6: 1-6
+    }
+    board.setSolved(2, 33, 6); // center col 6 (same canvas col): 7, 8, 9
+    board.setSolved(2, 42, 7);
+    board.setSolved(2, 51, 8);
+    EXPECT_EQ(board.availableValues(1, 54), 0);
+
+    stats = {};
+    EXPECT_EQ(solveInto(board, solved, stack, MultiGridOptions{}, stats), SolveStatus::unsolvable);
+    EXPECT_FALSE(solve(board).has_value());
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "susolv/board.h"
+#include "susolv/perfCounters.h"
+
+TEST(PerfCountersSuite, ProfiledSolveMatchesPlainSolve) {
+    Board board = loadBoard(SUSOLV_BOARDS_DIR "euler96-29.txt");
+
+    KernelProfile profile;
+    SolveOptions options;
+    options.profile = &profile;
+
+    SolveResult plain = solve(board, SolveOptions{});
+    SolveResult profiledResult = solve(board, options);
+
+    ASSERT_EQ(profiledResult.status, SolveStatus::solved);
+    EXPECT_EQ(profiledResult.stats.nodes, plain.stats.nodes);
+    for (uint8_t i = 0; i < 81; ++i) {
+        EXPECT_EQ(profiledResult.board.getSolvedValue(i), plain.board.getSolvedValue(i));
+    }
+
+    EXPECT_EQ(profile[ProfiledKernel::solveLoop].calls, 1);
+    EXPECT_EQ(profile[ProfiledKernel::fullComputeTakenVals].calls, 1);
+    EXPECT_EQ(profile[ProfiledKernel::simpleSolve].calls, plain.stats.nodes);
+    EXPECT_GT(profile[ProfiledKernel::branch].calls, 0);
+    EXPECT_EQ(profile[ProfiledKernel::seededBranch].calls, 0);
+    EXPECT_EQ(profile.group.owner(), std::this_thread::get_id());
+}
+
+TEST(PerfCountersSuite, SeededSearchChargesSeededBranch) {
+    Board board = loadBoard(SUSOLV_BOARDS_DIR "euler96-29.txt");
+
+    KernelProfile profile;
+    SolveOptions options;
+    options.profile = &profile;
+    options.seed = 7;
+
+    ASSERT_EQ(solve(board, options).status, SolveStatus::solved);
+    EXPECT_EQ(profile[ProfiledKernel::branch].calls, 0);
+    EXPECT_GT(profile[ProfiledKernel::seededBranch].calls, 0);
+}
+
+TEST(PerfCountersSuite, DegradesWithoutCounters) {
+    PerfCounterGroup group;
+
+    if (!group.available()) {
+        // whatever the reason, it's said, and reads are harmless zeros
+        EXPECT_FALSE(group.unavailableReason().empty());
+        CounterSample sample = group.read();
+        for (uint64_t value : sample.values) {
+            EXPECT_EQ(value, 0);
+        }
+    }
+    else {
+        EXPECT_EQ(group.has(PerfCounter::cycles), true);
+        EXPECT_GT(group.read().values[static_cast<size_t>(PerfCounter::cycles)], 0);
+    }
+}
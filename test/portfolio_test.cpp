@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "susolv/batch.h"
+#include "susolv/portfolio.h"
+#include "susolv/verify.h"
+
+// ai escargot
+static const char* HARD = "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+
+TEST(PortfolioSuite, SeededSearchesSolve) {
+    Board board;
+    ASSERT_EQ(parseBoard(HARD, board), true);
+
+    for (uint64_t seed = 1; seed <= 8; ++seed) {
+        SolveOptions options;
+        options.seed = seed;
+        SolveResult result = solve(board, options);
+        ASSERT_EQ(result.status, SolveStatus::solved);
+        EXPECT_EQ(verifySolution(board, result.board), VerifyStatus::valid);
+    }
+}
+
+TEST(PortfolioSuite, EasyPuzzlesSkipTheRace) {
+    Board board = loadBoard(SUSOLV_BOARDS_DIR "euler96-29.txt");
+
+    SolveResult plain = solve(board, SolveOptions{});
+    SolveResult portfolio = solvePortfolio(board, PortfolioOptions{});
+
+    ASSERT_EQ(portfolio.status, SolveStatus::solved);
+    EXPECT_EQ(portfolio.stats.nodes, plain.stats.nodes);
+}
+
+TEST(PortfolioSuite, RacesPastTheThreshold) {
+    Board board;
+    ASSERT_EQ(parseBoard(HARD, board), true);
+
+    PortfolioOptions options;
+    options.nodeThreshold = 10;
+    options.workers = 3;
+
+    SolveResult result = solvePortfolio(board, options);
+    ASSERT_EQ(result.status, SolveStatus::solved);
+    EXPECT_GT(result.stats.nodes, options.nodeThreshold);
+    EXPECT_EQ(verifySolution(board, result.board), VerifyStatus::valid);
+}
+
+TEST(PortfolioSuite, BitboardPlainPhaseStillRacesSeeded) {
+    Board board;
+    ASSERT_EQ(parseBoard(HARD, board), true);
+
+    PortfolioOptions options;
+    options.nodeThreshold = 10;
+    options.workers = 2;
+    options.limits.engine = SolveEngine::bitboard;
+
+    SolveResult result = solvePortfolio(board, options);
+    ASSERT_EQ(result.status, SolveStatus::solved);
+    EXPECT_EQ(verifySolution(board, result.board), VerifyStatus::valid);
+}
+
+TEST(PortfolioSuite, RacersShareTheCallersBudget) {
+    Board board;
+    ASSERT_EQ(parseBoard(HARD, board), true);
+
+    PortfolioOptions options;
+    options.nodeThreshold = 10;
+    options.workers = 4;
+    options.limits.nodeBudget = 50;
+
+    SolveResult result = solvePortfolio(board, options);
+    EXPECT_EQ(result.status, SolveStatus::timedOut);
+    EXPECT_LE(result.stats.nodes, options.limits.nodeBudget);
+}
+
+TEST(PortfolioSuite, SeedsWrapPastZero) {
+    Board board;
+    ASSERT_EQ(parseBoard(HARD, board), true);
+
+    PortfolioOptions options;
+    options.nodeThreshold = 10;
+    options.workers = 3;
+    options.seed = UINT64_MAX;
+
+    SolveResult result = solvePortfolio(board, options);
+    ASSERT_EQ(result.status, SolveStatus::solved);
+    EXPECT_EQ(verifySolution(board, result.board), VerifyStatus::valid);
+}
+
+TEST(PortfolioSuite, CallerCancelStopsTheRace) {
+    Board board;
+    for (uint8_t i = 0; i < 81; ++i) {
+        board.setUnknown(i);
+    }
+
+    std::stop_source source;
+    source.request_stop();
+
+    PortfolioOptions options;
+    options.nodeThreshold = 0;
+    options.limits.stopToken = source.get_token();
+
+    EXPECT_EQ(solvePortfolio(board, options).status, SolveStatus::cancelled);
+}
@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <deque>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "susolv/batch.h"
+#include "susolv/euler96.h"
+#include "susolv/perfCounters.h"
+#include "susolv/schedule.h"
+
+TEST(ScheduleSuite, ProbeOfEasyPuzzleIsSettled) {
+    // euler96 grid 1 falls to naked singles
+    Board board;
+    ASSERT_TRUE(parseBoard("003020600900305001001806400008102900700000008006708200002609500800203009005010300", board));
+
+    const PuzzleProbe probe = probePuzzle(board);
+    EXPECT_EQ(probe.clues, 32);
+    EXPECT_TRUE(probe.settled);
+    EXPECT_EQ(probe.unsolved, 0);
+    EXPECT_EQ(probe.entropy, 0.f);
+    EXPECT_EQ(probe.predictedNodes, 1.f);
+}
+
+TEST(ScheduleSuite, ProbeOfEmptyBoard) {
+    Board board;
+    ASSERT_TRUE(parseBoard(std::string(BOARD_CELLS, '0').c_str(), board));
+
+    const PuzzleProbe probe = probePuzzle(board);
+    EXPECT_EQ(probe.clues, 0);
+    EXPECT_FALSE(probe.settled);
+    EXPECT_EQ(probe.unsolved, 81);
+    EXPECT_NEAR(probe.entropy, 81 * 3.169925f, 1e-3f);
+}
+
+TEST(ScheduleSuite, HarderPuzzlesArePredictedCostlier) {
+    std::vector<Board> easy = loadEuler96(SUSOLV_BOARDS_DIR "euler96-all.txt");
+    std::vector<Board> hard = loadPackedBoards(SUSOLV_BOARDS_DIR "17clue.txt");
+    ASSERT_FALSE(easy.empty());
+    ASSERT_FALSE(hard.empty());
+
+    auto meanPrediction = [](const std::vector<Board>& boards) {
+        double sum = 0;
+        for (const Board& board : boards) {
+            sum += probePuzzle(board).predictedNodes;
+        }
+        return sum / boards.size();
+    };
+    EXPECT_GT(meanPrediction(hard), meanPrediction(easy));
+}
+
+TEST(ScheduleSuite, LongestPredictedFirstOrder) {
+    std::vector<Board> boards = loadPackedBoards(SUSOLV_BOARDS_DIR "hard.txt");
+    boards.resize(20);
+
+    std::vector<Board> solved;
+    ScheduleOptions options;
+    options.workers = 1;
+    ScheduleReport report;
+    solveScheduled(boards, solved, options, report);
+
+    ASSERT_EQ(report.order.size(), boards.size());
+    for (size_t i = 1; i < report.order.size(); ++i) {
+        EXPECT_GE(report.puzzles[report.order[i - 1]].probe.predictedNodes, report.puzzles[report.order[i]].probe.predictedNodes);
+    }
+    std::vector<size_t> sorted = report.order;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        EXPECT_EQ(sorted[i], i);
+    }
+}
+
+TEST(ScheduleSuite, MatchesSequentialSolves) {
+    std::vector<Board> boards = loadPackedBoards(SUSOLV_BOARDS_DIR "hard.txt");
+    boards.resize(30);
+
+    std::deque<Board> queue;
+    std::vector<Board> expected(boards.size());
+    std::vector<uint64_t> expectedNodes(boards.size());
+    for (size_t i = 0; i < boards.size(); ++i) {
+        SolveStats stats;
+        ASSERT_EQ(solveInto(boards[i], expected[i], queue, SolveOptions{}, stats), SolveStatus::solved);
+        expectedNodes[i] = stats.nodes;
+    }
+
+    for (unsigned workers : { 1u, 3u }) {
+        for (BatchOrder order : { BatchOrder::input, BatchOrder::longestPredictedFirst }) {
+            std::vector<Board> solved;
+            ScheduleOptions options;
+            options.workers = workers;
+            options.order = order;
+            ScheduleReport report;
+            solveScheduled(boards, solved, options, report);
+
+            ASSERT_EQ(report.puzzles.size(), boards.size());
+            for (size_t i = 0; i < boards.size(); ++i) {
+                EXPECT_EQ(report.puzzles[i].status, SolveStatus::solved);
+                EXPECT_EQ(report.puzzles[i].nodes, expectedNodes[i]);
+                EXPECT_LT(report.puzzles[i].worker, workers);
+                for (uint8_t cell = 0; cell < BOARD_CELLS; ++cell) {
+                    EXPECT_EQ(solved[i].getSolvedValue(cell), expected[i].getSolvedValue(cell));
+                }
+            }
+        }
+    }
+}
+
+TEST(ScheduleSuite, WorkersLeaveTheCallersProfileAlone) {
+    std::vector<Board> boards = loadPackedBoards(SUSOLV_BOARDS_DIR "hard.txt");
+    boards.resize(6);
+
+    KernelProfile profile;
+    std::vector<Board> solved;
+    ScheduleOptions options;
+    options.workers = 3;
+    options.solve.profile = &profile;
+    ScheduleReport report;
+    solveScheduled(boards, solved, options, report);
+
+    for (const ScheduledSolve& puzzle : report.puzzles) {
+        EXPECT_EQ(puzzle.status, SolveStatus::solved);
+    }
+    EXPECT_EQ(profile[ProfiledKernel::solveLoop].calls, 0);
+
+    // on the calling thread it's used as usual
+    options.workers = 1;
+    solveScheduled(boards, solved, options, report);
+    EXPECT_EQ(profile[ProfiledKernel::solveLoop].calls, boards.size());
+}
+
+TEST(ScheduleSuite, PoolMatchesSequentialSolves) {
+    std::vector<Board> boards = loadPackedBoards(SUSOLV_BOARDS_DIR "hard.txt");
+    boards.resize(30);
+
+    std::deque<Board> queue;
+    std::vector<Board> expected(boards.size());
+    std::vector<uint64_t> expectedNodes(boards.size());
+    for (size_t i = 0; i < boards.size(); ++i) {
+        SolveStats stats;
+        ASSERT_EQ(solveInto(boards[i], expected[i], queue, SolveOptions{}, stats), SolveStatus::solved);
+        expectedNodes[i] = stats.nodes;
+    }
+
+    for (BatchOrder order : { BatchOrder::input, BatchOrder::longestPredictedFirst }) {
+        ScheduleOptions options;
+        options.workers = 3;
+        options.order = order;
+        SchedulePool pool(options);
+
+        // tickets needn't start at 0 or match the submission index
+        const uint64_t base = 1000;
+        std::vector<PooledSolve> done;
+        for (size_t i = 0; i < boards.size(); ++i) {
+            pool.submit(base + i, boards[i]);
+            if (i % 7 == 6) {
+                pool.collect(done);
+            }
+        }
+        while (pool.outstanding() > 0) {
+            pool.collect(done);
+        }
+        pool.collect(done); // nothing outstanding: returns straight away
+
+        ASSERT_EQ(done.size(), boards.size());
+        std::vector<bool> seen(boards.size());
+        for (const PooledSolve& result : done) {
+            ASSERT_GE(result.ticket, base);
+            const size_t i = result.ticket - base;
+            ASSERT_LT(i, boards.size());
+            EXPECT_FALSE(seen[i]);
+            seen[i] = true;
+            EXPECT_EQ(result.status, SolveStatus::solved);
+            EXPECT_EQ(result.nodes, expectedNodes[i]);
+            for (uint8_t cell = 0; cell < BOARD_CELLS; ++cell) {
+                EXPECT_EQ(result.solved.getSolvedValue(cell), expected[i].getSolvedValue(cell));
+            }
+        }
+    }
+}
+
+TEST(ScheduleSuite, PoolCancelsOnDestruction) {
+    std::vector<Board> boards = loadPackedBoards(SUSOLV_BOARDS_DIR "hard.txt");
+
+    ScheduleOptions options;
+    options.workers = 2;
+    SchedulePool pool(options);
+    for (size_t i = 0; i < boards.size(); ++i) {
+        pool.submit(i, boards[i]);
+    }
+    // leaving the scope with puzzles queued and running mustn't hang or touch freed state
+}
+
+TEST(ScheduleSuite, ListScheduleMakespan) {
+    const std::vector<double> costs = { 1, 1, 1, 3 };
+
+    // the long job last leaves one worker busy for 3 after the other finishes
+    EXPECT_EQ(listScheduleMakespan(costs, { 0, 1, 2, 3 }, 2), 4.0);
+    EXPECT_EQ(listScheduleMakespan(costs, { 3, 0, 1, 2 }, 2), 3.0);
+    EXPECT_EQ(listScheduleMakespan(costs, { 0, 1, 2, 3 }, 1), 6.0);
+    EXPECT_EQ(listScheduleMakespan(costs, { 0, 1, 2, 3 }, 8), 3.0);
+}
@@ -0,0 +1,149 @@
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "susolv/batch.h"
+#include "susolv/board.h"
+#include "susolv/searchTrace.h"
+
+static Board hardBoard() {
+    return loadPackedBoards(SUSOLV_BOARDS_DIR "hard.txt").front();
+}
+
+TEST(SearchTraceSuite, RingKeepsTheNewestEvents) {
+    SearchTrace trace(3); // rounded up to 4
+    EXPECT_EQ(trace.capacity(), 4);
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        trace.record({ i, TraceEventKind::propagate, 0, 0, 0 });
+    }
+
+    EXPECT_EQ(trace.recorded(), 10);
+    EXPECT_EQ(trace.dropped(), 6);
+    const std::vector<TraceEvent> events = trace.events();
+    ASSERT_EQ(events.size(), 4);
+    for (uint32_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(events[i].node, 6 + i);
+    }
+}
+
+TEST(SearchTraceSuite, FileRoundTrip) {
+    const std::string path = (std::filesystem::temp_directory_path() / "susolv_search_trace_test.trace").string();
+
+    SearchTrace trace(8);
+    trace.record({ 0, TraceEventKind::start, 0, 0, 17 });
+    trace.record({ 0, TraceEventKind::propagate, 0, 0, 5 });
+    trace.record({ 0, TraceEventKind::branch, 0, 40, 9 });
+    ASSERT_TRUE(trace.writeFile(path.c_str()));
+
+    TraceFile file;
+    ASSERT_TRUE(readTraceFile(path.c_str(), file));
+    EXPECT_EQ(file.recorded, 3);
+    EXPECT_EQ(file.dropped, 0);
+    ASSERT_EQ(file.events.size(), 3);
+    EXPECT_EQ(file.events[2].kind, TraceEventKind::branch);
+    EXPECT_EQ(file.events[2].cell, 40);
+    EXPECT_EQ(file.events[2].arg, 9);
+
+    FILE* f = fopen(path.c_str(), "wb");
+    fputs("not a trace", f);
+    fclose(f);
+    EXPECT_FALSE(readTraceFile(path.c_str(), file));
+
+    std::filesystem::remove(path);
+}
+
+TEST(SearchTraceSuite, StreamedTraceKeepsEverything) {
+    const std::string path = (std::filesystem::temp_directory_path() / "susolv_search_trace_stream.trace").string();
+
+    {
+        SearchTrace trace(path.c_str(), 4);
+        ASSERT_TRUE(trace.ok());
+        EXPECT_TRUE(trace.streamed());
+        for (uint32_t i = 0; i < 10; ++i) {
+            trace.record({ i, TraceEventKind::propagate, 0, 0, 0 });
+        }
+        EXPECT_EQ(trace.dropped(), 0);
+
+        // two ring's worth are out already, and the header says so
+        TraceFile partial;
+        ASSERT_TRUE(readTraceFile(path.c_str(), partial));
+        EXPECT_EQ(partial.events.size(), 0);
+        ASSERT_TRUE(trace.flush());
+        ASSERT_TRUE(readTraceFile(path.c_str(), partial));
+        EXPECT_EQ(partial.events.size(), 10);
+
+        trace.record({ 10, TraceEventKind::solved, 0, 0, 0 });
+    }
+
+    TraceFile file;
+    ASSERT_TRUE(readTraceFile(path.c_str(), file));
+    EXPECT_EQ(file.recorded, 11);
+    EXPECT_EQ(file.dropped, 0);
+    ASSERT_EQ(file.events.size(), 11);
+    for (uint32_t i = 0; i < 11; ++i) {
+        EXPECT_EQ(file.events[i].node, i);
+    }
+    EXPECT_EQ(file.events.back().kind, TraceEventKind::solved);
+
+    std::filesystem::remove(path);
+}
+
+TEST(SearchTraceSuite, RecordsTheSearch) {
+    if constexpr (!TRACE_ENABLED) {
+        GTEST_SKIP() << "built without SUSOLV_TRACE";
+    }
+
+    const Board board = hardBoard();
+    SearchTrace trace;
+    SolveOptions options;
+    options.trace = &trace;
+    const SolveResult result = solve(board, options);
+    ASSERT_EQ(result.status, SolveStatus::solved);
+    EXPECT_EQ(trace.dropped(), 0);
+
+    const std::vector<TraceEvent> events = trace.events();
+    ASSERT_GE(events.size(), 3);
+    EXPECT_EQ(events.front().kind, TraceEventKind::start);
+    EXPECT_EQ(events.back().kind, TraceEventKind::solved);
+
+    uint64_t nodes = 0;
+    uint8_t depth = 0;
+    for (const TraceEvent& event : events) {
+        // breadth first: depth never goes back up
+        EXPECT_GE(event.depth, depth);
+        depth = event.depth;
+
+        if (event.kind == TraceEventKind::propagate) {
+            EXPECT_EQ(event.node, nodes);
+            ++nodes;
+        }
+        if (event.kind == TraceEventKind::branch) {
+            EXPECT_LT(event.cell, 81);
+            EXPECT_FALSE(board.isSolved(event.cell) && board.getSolvedValue(event.cell) != event.arg);
+            EXPECT_GE(event.arg, 1);
+            EXPECT_LE(event.arg, 9);
+        }
+    }
+    EXPECT_EQ(nodes, result.stats.nodes);
+    EXPECT_GT(depth, 0);
+
+    // a search cut short ends in `stopped`
+    trace.clear();
+    options.nodeBudget = 10;
+    EXPECT_EQ(solve(board, options).status, SolveStatus::timedOut);
+    EXPECT_EQ(trace.events().back().kind, TraceEventKind::stopped);
+}
+
+TEST(SearchTraceSuite, TracingOffRecordsNothing) {
+    if constexpr (TRACE_ENABLED) {
+        GTEST_SKIP() << "built with SUSOLV_TRACE";
+    }
+
+    SearchTrace trace;
+    SolveOptions options;
+    options.trace = &trace;
+    EXPECT_EQ(solve(hardBoard(), options).status, SolveStatus::solved);
+    EXPECT_EQ(trace.recorded(), 0);
+}
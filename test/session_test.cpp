@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "susolv/batch.h"
+#include "susolv/solverSession.h"
+
+static const char* PUZZLE   = "003020600900305001001806400008102900700000008006708200002609500800203009005010300";
+static const char* SOLUTION = "483921657967345821251876493548132976729564138136798245372689514814253769695417382";
+
+static Board parsed(const char* cells) {
+    Board board;
+    EXPECT_EQ(parseBoard(cells, board), true);
+    return board;
+}
+
+static bool solutionFits(const SolverSession& session) {
+    const Board* solution = session.solution();
+    if (!solution) {
+        return false;
+    }
+    for (uint8_t i = 0; i < 81; ++i) {
+        if (session.clues().isSolved(i) && session.clues().getSolvedValue(i) != solution->getSolvedValue(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(SessionSuite, SolvesOnConstruction) {
+    SolverSession session(parsed(PUZZLE));
+    ASSERT_NE(session.solution(), nullptr);
+    for (uint8_t i = 0; i < 81; ++i) {
+        EXPECT_EQ(session.solution()->getSolvedValue(i), SOLUTION[i] - '0');
+    }
+}
+
+TEST(SessionSuite, ReusesSolutionWhenItStillHolds) {
+    SolverSession session(parsed(PUZZLE));
+
+    // cell 0 is empty, and the solution has a 4 there
+    EditResult placed = session.placeClue(0, 4);
+    EXPECT_EQ(placed.status, EditStatus::solved);
+    EXPECT_EQ(placed.reused, true);
+
+    // cell 2 is a clue (3)
+    EditResult removed = session.removeClue(2);
+    EXPECT_EQ(removed.status, EditStatus::solved);
+    EXPECT_EQ(removed.reused, true);
+    EXPECT_EQ(session.clues().isSolved(static_cast<uint8_t>(2)), false);
+}
+
+TEST(SessionSuite, ContradictionsAreReportedWithoutSearch) {
+    SolverSession session(parsed(PUZZLE));
+
+    // row 0 already has a 3 at cell 2
+    EditResult clash = session.placeClue(0, 3);
+    EXPECT_EQ(clash.status, EditStatus::contradiction);
+    EXPECT_EQ(clash.stats.nodes, 0);
+    EXPECT_EQ(session.solution(), nullptr);
+
+    // taking it back out restores the old solution
+    EditResult undo = session.removeClue(0);
+    EXPECT_EQ(undo.status, EditStatus::solved);
+    EXPECT_EQ(undo.reused, true);
+}
+
+TEST(SessionSuite, ResolvesWhenTheSolutionNoLongerFits) {
+    SolverSession session(parsed(PUZZLE));
+
+    // cell 0 can locally be 4 or 5, but only 4 leads anywhere
+    EditResult wrong = session.placeClue(0, 5);
+    EXPECT_EQ(wrong.status, EditStatus::unsolvable);
+    EXPECT_EQ(wrong.reused, false);
+    EXPECT_GT(wrong.stats.nodes, 0);
+    EXPECT_EQ(session.solution(), nullptr);
+
+    EditResult undo = session.removeClue(0);
+    EXPECT_EQ(undo.status, EditStatus::solved);
+    EXPECT_EQ(undo.reused, true);
+}
+
+TEST(SessionSuite, SearchesWhenThereIsNoSolutionToReuse) {
+    std::string wrong = PUZZLE;
+    wrong[0] = '5';
+    SolverSession session(parsed(wrong.data()));
+    EXPECT_EQ(session.lastResult().status, EditStatus::unsolvable);
+
+    EditResult fixed = session.placeClue(0, 4);
+    EXPECT_EQ(fixed.status, EditStatus::solved);
+    EXPECT_EQ(fixed.reused, false);
+    EXPECT_GT(fixed.stats.nodes, 0);
+    EXPECT_EQ(solutionFits(session), true);
+}
+
+TEST(SessionSuite, ReplacingAClueRecomputesItsUnits) {
+    SolverSession session(parsed(PUZZLE));
+
+    // cell 2 holds a 3; overwrite it with a value that's a contradiction, then with the right one again
+    EXPECT_EQ(session.placeClue(2, 6).status, EditStatus::contradiction); // 6 is at cell 6 in row 0
+    EditResult back = session.placeClue(2, 3);
+    EXPECT_EQ(back.status, EditStatus::solved);
+    EXPECT_EQ(solutionFits(session), true);
+}
+
+TEST(SessionSuite, OutOfRangeEditsChangeNothing) {
+    SolverSession session(parsed(PUZZLE));
+    const Board before = session.clues();
+
+    EXPECT_EQ(session.placeClue(0, 0).status, EditStatus::outOfRange);
+    EXPECT_EQ(session.placeClue(0, 10).status, EditStatus::outOfRange);
+    EXPECT_EQ(session.placeClue(81, 5).status, EditStatus::outOfRange);
+    EXPECT_EQ(session.removeClue(81).status, EditStatus::outOfRange);
+
+    for (uint8_t i = 0; i < 81; ++i) {
+        EXPECT_EQ(session.clues().cells[i], before.cells[i]);
+    }
+    EXPECT_EQ(session.lastResult().status, EditStatus::solved);
+    EXPECT_EQ(solutionFits(session), true);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "susolv/board.h"
+
+// with no clues the breadth-first search has to expand an enormous number of boards before it
+// reaches a full grid, so these runs end on whichever limit is set
+static Board emptyBoard() {
+    Board board;
+    for (uint8_t i = 0; i < 81; ++i) {
+        board.setUnknown(i);
+    }
+    return board;
+}
+
+TEST(SolveOptionsSuite, SolvesWithinLimits) {
+    Board board = loadBoard(SUSOLV_BOARDS_DIR "euler96-29.txt");
+
+    SolveOptions options;
+    options.deadline = SolveOptions::clock::now() + std::chrono::seconds(60);
+    options.nodeBudget = 1'000'000;
+
+    SolveResult result = solve(board, options);
+    EXPECT_EQ(result.status, SolveStatus::solved);
+    EXPECT_GT(result.stats.nodes, 0);
+    EXPECT_GT(result.stats.maxQueue, 0);
+    EXPECT_EQ(result.board.solvedIndices.boardIsFullySolved(), true);
+}
+
+TEST(SolveOptionsSuite, NodeBudget) {
+    SolveOptions options;
+    options.nodeBudget = 100;
+
+    SolveResult result = solve(emptyBoard(), options);
+    EXPECT_EQ(result.status, SolveStatus::timedOut);
+    EXPECT_EQ(result.stats.nodes, 100);
+}
+
+TEST(SolveOptionsSuite, Deadline) {
+    SolveOptions options;
+    options.deadline = SolveOptions::clock::now() + std::chrono::milliseconds(5);
+
+    SolveResult result = solve(emptyBoard(), options);
+    EXPECT_EQ(result.status, SolveStatus::timedOut);
+    EXPECT_GT(result.stats.nodes, 0);
+}
+
+TEST(SolveOptionsSuite, Cancelled) {
+    std::stop_source source;
+    source.request_stop();
+
+    SolveOptions options;
+    options.stopToken = source.get_token();
+
+    SolveResult result = solve(emptyBoard(), options);
+    EXPECT_EQ(result.status, SolveStatus::cancelled);
+    EXPECT_EQ(result.stats.nodes, 0);
+}
+
+TEST(SolveOptionsSuite, Unsolvable) {
+    const uint8_t input[9][9] = {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8},
+        {9, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+    };
+
+    SolveResult result = solve(Board(input), SolveOptions{});
+    EXPECT_EQ(result.status, SolveStatus::unsolvable);
+    EXPECT_EQ(result.stats.nodes, 1);
+}
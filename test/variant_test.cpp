@@ -0,0 +1,136 @@
+#include <string>
+
+#include <gtest/gtest.h>
+#include "susolv/batch.h"
+#include "susolv/variantBoard.h"
+
+template<typename Layout>
+static bool everyUnitComplete(const VariantBoard<Layout>& board) {
+    const auto& table = board.table();
+    for (size_t unit = 0; unit < VariantBoard<Layout>::Table::UNIT_COUNT; ++unit) {
+        uint16_t seen = 0;
+        for (int i = 0; i < 9; ++i) {
+            seen |= 1 << (board.getSolvedValue(table.unitCells[unit][i]) - 1);
+        }
+        if (seen != Board::ALL_VALUES_MASK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// every third cell blanked out of a full grid
+static std::string blanked(const char* grid) {
+    std::string puzzle = grid;
+    for (size_t i = 0; i < puzzle.size(); i += 3) {
+        puzzle[i] = '0';
+    }
+    return puzzle;
+}
+
+template<typename Layout>
+static void expectSolvesBack(const char* grid, Layout layout = Layout{}) {
+    VariantBoard<Layout> puzzle(layout);
+    ASSERT_EQ(parseBoard(blanked(grid).data(), puzzle), true);
+
+    std::optional<VariantBoard<Layout>> solved = solve(puzzle);
+    ASSERT_EQ(solved.has_value(), true);
+    EXPECT_EQ(everyUnitComplete(*solved), true);
+
+    // the blanked grid need not be a unique puzzle, so only the clues have to come back
+    for (uint8_t i = 0; i < 81; ++i) {
+        if (puzzle.isSolved(i)) {
+            EXPECT_EQ(solved->getSolvedValue(i), grid[i] - '0');
+        }
+    }
+}
+
+TEST(VariantSuite, StandardTableMatchesCellIndexLookup) {
+    const auto& table = StandardLayout::TABLE;
+    for (uint8_t cell = 0; cell < 81; ++cell) {
+        EXPECT_EQ(table.unitCounts[cell], 3);
+        EXPECT_EQ(table.cellUnits[cell][0], cellIndexLookup.indexToRow[cell]);
+        EXPECT_EQ(table.cellUnits[cell][1], 9 + cellIndexLookup.indexToCol[cell]);
+        EXPECT_EQ(table.cellUnits[cell][2], 18 + cellIndexLookup.indexToQuad[cell]);
+
+        ASSERT_EQ(table.peerCounts[cell], 20);
+        for (uint8_t k = 0; k < 20; ++k) {
+            const uint8_t peer = table.peers[cell][k];
+            EXPECT_NE(peer, cell);
+            EXPECT_TRUE(cellIndexLookup.indexToRow[peer] == cellIndexLookup.indexToRow[cell]
+                || cellIndexLookup.indexToCol[peer] == cellIndexLookup.indexToCol[cell]
+                || cellIndexLookup.indexToQuad[peer] == cellIndexLookup.indexToQuad[cell]);
+        }
+    }
+}
+
+TEST(VariantSuite, CellClasses) {
+    // the center is on both diagonals, cell 1 on neither, cell 0 on one
+    const auto& diagonal = DiagonalLayout::TABLE;
+    EXPECT_EQ(diagonal.unitCounts[40], 5);
+    EXPECT_EQ(diagonal.cellUnits[40][3], 27);
+    EXPECT_EQ(diagonal.cellUnits[40][4], 28);
+    EXPECT_EQ(diagonal.peerCounts[40], 32);
+    EXPECT_EQ(diagonal.unitCounts[1], 3);
+    EXPECT_EQ(diagonal.peerCounts[1], 20);
+    EXPECT_EQ(diagonal.unitCounts[0], 4);
+    EXPECT_EQ(diagonal.peerCounts[0], 26);
+
+    // (1, 1) is in the first window, (0, 0) in none
+    const auto& hyper = HyperLayout::TABLE;
+    EXPECT_EQ(hyper.unitCounts[10], 4);
+    EXPECT_EQ(hyper.cellUnits[10][3], 27);
+    EXPECT_EQ(hyper.unitCounts[0], 3);
+    EXPECT_EQ(hyper.peerCounts[0], 20);
+}
+
+TEST(VariantSuite, StandardMatchesBoard) {
+    const char* puzzle = "003020600900305001001806400008102900700000008006708200002609500800203009005010300";
+
+    Board board;
+    VariantBoard<StandardLayout> variant;
+    ASSERT_EQ(parseBoard(puzzle, board), true);
+    ASSERT_EQ(parseBoard(puzzle, variant), true);
+
+    std::optional<Board> solvedBoard = solve(board);
+    std::optional<VariantBoard<StandardLayout>> solvedVariant = solve(variant);
+    ASSERT_EQ(solvedBoard.has_value(), true);
+    ASSERT_EQ(solvedVariant.has_value(), true);
+
+    for (uint8_t i = 0; i < 81; ++i) {
+        EXPECT_EQ(solvedVariant->getSolvedValue(i), solvedBoard->getSolvedValue(i));
+    }
+}
+
+TEST(VariantSuite, Diagonal) {
+    const char* grid = "421869537958473126376125894563741289789236451142598763834612975297354618615987342";
+    expectSolvesBack<DiagonalLayout>(grid);
+
+    // a plain sudoku grid whose diagonals repeat is rejected up front
+    VariantBoard<DiagonalLayout> board;
+    EXPECT_EQ(parseBoard("483921657967345821251876493548132976729564138136798245372689514814253769695417382", board), false);
+}
+
+TEST(VariantSuite, Hyper) {
+    expectSolvesBack<HyperLayout>("421869537958273461376145298549328176167594823283716954715682349692431785834957612");
+}
+
+TEST(VariantSuite, Jigsaw) {
+    JigsawLayout::Table table;
+    ASSERT_EQ(loadJigsawTable(SUSOLV_BOARDS_DIR "jigsaw-regions.txt", table), true);
+    expectSolvesBack("421869537958473126376125948863541279214937865795286413532794681689312754147658392", JigsawLayout(table));
+}
+
+TEST(VariantSuite, JigsawRegionsMustHaveNineCells) {
+    uint8_t regionOf[81];
+    for (uint8_t cell = 0; cell < 81; ++cell) {
+        regionOf[cell] = cellIndexLookup.indexToQuad[cell];
+    }
+
+    JigsawLayout::Table table;
+    EXPECT_EQ(makeJigsawTable(regionOf, table), true);
+    EXPECT_EQ(table.peerCounts[0], 20); // quads as regions are just the standard layout
+
+    regionOf[0] = 1;
+    EXPECT_EQ(makeJigsawTable(regionOf, table), false);
+}
@@ -0,0 +1,127 @@
+#include <random>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include "susolv/batch.h"
+#include "susolv/susolv.h"
+#include "susolv/verify.h"
+
+// euler96 grid 01 and its solution
+static const char* PUZZLE   = "003020600900305001001806400008102900700000008006708200002609500800203009005010300";
+static const char* SOLUTION = "483921657967345821251876493548132976729564138136798245372689514814253769695417382";
+
+static VerifyStatus verifyBoth(const std::string& puzzle, const std::string& grid) {
+    const VerifyStatus status = verifySolution(puzzle.data(), grid.data());
+    EXPECT_EQ(status, verifySolutionScalar(puzzle.data(), grid.data()));
+    return status;
+}
+
+TEST(VerifySuite, AcceptsTheSolution) {
+    EXPECT_EQ(verifyBoth(PUZZLE, SOLUTION), VerifyStatus::valid);
+
+    std::string dotted = PUZZLE;
+    for (char& c : dotted) {
+        if (c == '0') c = '.';
+    }
+    EXPECT_EQ(verifyBoth(dotted, SOLUTION), VerifyStatus::valid);
+    EXPECT_EQ(verifyBoth(std::string(BOARD_CELLS, '0'), SOLUTION), VerifyStatus::valid);
+}
+
+TEST(VerifySuite, RejectsMalformedBytes) {
+    for (size_t cell : { 0, 15, 16, 63, 64, 80 }) {
+        for (char c : { '0', '.', 'a', ':', '/', '\0', '\xb1' }) {
+            std::string grid = SOLUTION;
+            grid[cell] = c;
+            EXPECT_EQ(verifyBoth(PUZZLE, grid), VerifyStatus::malformed) << cell << " " << int(c);
+        }
+
+        std::string puzzle = PUZZLE;
+        puzzle[cell] = 'x';
+        EXPECT_EQ(verifyBoth(puzzle, SOLUTION), VerifyStatus::malformed) << cell;
+    }
+}
+
+TEST(VerifySuite, RejectsChangedClues) {
+    // swapping two clues of a row breaks cols too, but the clues are checked first
+    std::string grid = SOLUTION;
+    std::swap(grid[2], grid[4]); // both clues of row 0
+    EXPECT_EQ(verifyBoth(PUZZLE, grid), VerifyStatus::clueMismatch);
+
+    // a valid grid for a different puzzle: relabel digits 1 <-> 2
+    std::string relabeled = SOLUTION;
+    for (char& c : relabeled) {
+        c = c == '1' ? '2' : c == '2' ? '1' : c;
+    }
+    EXPECT_EQ(verifyBoth(std::string(BOARD_CELLS, '0'), relabeled), VerifyStatus::valid);
+    EXPECT_EQ(verifyBoth(PUZZLE, relabeled), VerifyStatus::clueMismatch);
+}
+
+TEST(VerifySuite, RejectsBrokenUnits) {
+    const std::string blank(BOARD_CELLS, '0');
+
+    // same digit twice in a row, col, quad; or rows swapped across bands (rows fine, quads broken)
+    std::string grid = SOLUTION;
+    grid[0] = grid[1];
+    EXPECT_EQ(verifyBoth(blank, grid), VerifyStatus::unitViolation);
+
+    grid = SOLUTION;
+    std::swap(grid[0], grid[1]); // rows still whole, cols 0 and 1 not
+    EXPECT_EQ(verifyBoth(blank, grid), VerifyStatus::unitViolation);
+
+    grid = SOLUTION;
+    std::swap_ranges(grid.begin(), grid.begin() + 9, grid.begin() + 27); // rows and cols whole, quads not
+    EXPECT_EQ(verifyBoth(blank, grid), VerifyStatus::unitViolation);
+
+    grid = SOLUTION;
+    std::swap_ranges(grid.begin(), grid.begin() + 9, grid.begin() + 9); // within a band: still a solution
+    EXPECT_EQ(verifyBoth(blank, grid), VerifyStatus::valid);
+}
+
+TEST(VerifySuite, MatchesScalarOnRandomDamage) {
+    std::mt19937 rng(96);
+    std::uniform_int_distribution<size_t> cell(0, BOARD_CELLS - 1);
+    std::uniform_int_distribution<int> digit('1', '9');
+
+    for (int i = 0; i < 2000; ++i) {
+        std::string puzzle = PUZZLE;
+        std::string grid = SOLUTION;
+        for (int n = rng() % 3; n > 0; --n) {
+            grid[cell(rng)] = static_cast<char>(digit(rng));
+        }
+        if (rng() % 8 == 0) {
+            puzzle[cell(rng)] = static_cast<char>(digit(rng));
+        }
+        verifyBoth(puzzle, grid);
+    }
+}
+
+TEST(VerifySuite, Boards) {
+    Board puzzle;
+    Board solution;
+    ASSERT_TRUE(parseBoard(PUZZLE, puzzle));
+    ASSERT_TRUE(parseBoard(SOLUTION, solution));
+    EXPECT_EQ(verifySolution(puzzle, solution), VerifyStatus::valid);
+
+    // an unsolved cell packs as '0'
+    EXPECT_EQ(verifySolution(puzzle, puzzle), VerifyStatus::malformed);
+}
+
+TEST(VerifySuite, BatchAndCApi) {
+    std::string broken = SOLUTION;
+    broken[80] = broken[79]; // neither is a clue
+    std::string puzzles = std::string(PUZZLE) + PUZZLE + PUZZLE;
+    std::string grids = std::string(SOLUTION) + broken + SOLUTION;
+    VerifyStatus statuses[3];
+
+    EXPECT_EQ(verifyBatch(puzzles.data(), grids.data(), statuses, 3), 2);
+    EXPECT_EQ(statuses[0], VerifyStatus::valid);
+    EXPECT_EQ(statuses[1], VerifyStatus::unitViolation);
+    EXPECT_EQ(statuses[2], VerifyStatus::valid);
+    EXPECT_EQ(verifyBatch(puzzles.data(), grids.data(), nullptr, 3), 2);
+
+    uint8_t cStatuses[3];
+    EXPECT_EQ(susolv_verify_batch(puzzles.data(), grids.data(), cStatuses, 3), 2);
+    EXPECT_EQ(cStatuses[1], SUSOLV_VERIFY_UNIT_VIOLATION);
+    EXPECT_EQ(susolv_verify(PUZZLE, SOLUTION), SUSOLV_VERIFY_VALID);
+}